@@ -4,11 +4,35 @@
 #endif
 #include "leptjson.h"
 #include <assert.h>  /* assert() */
-#include <errno.h>   /* errno, ERANGE */
+#include <errno.h>   /* errno, ERANGE, EINTR */
 #include <math.h>    /* HUGE_VAL */
-#include <stdio.h>   /* sprintf() */
-#include <stdlib.h>  /* NULL, malloc(), realloc(), free(), strtod() */
-#include <string.h>  /* memcpy() */
+#include <stdio.h>   /* sprintf(), fwrite() */
+#include <stdlib.h>  /* NULL, malloc(), calloc(), realloc(), free(), strtod() */
+#include <string.h>  /* memcpy(), memmove(), memset(), strlen() */
+#if defined(_WIN32)
+#include <io.h>      /* _write() */
+#define write(fd, buf, len) _write(fd, buf, (unsigned)(len))
+#else
+#include <unistd.h>  /* write() */
+#endif
+
+#if defined(_MSC_VER) && _MSC_VER < 1600
+typedef unsigned __int64 lept_uint64;
+#else
+#include <stdint.h>  /* uint64_t */
+typedef uint64_t lept_uint64;
+#endif
+
+#ifndef LEPT_NO_SIMD
+#if defined(__AVX2__)
+#define LEPT_AVX2
+#define LEPT_SSE2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LEPT_SSE2
+#include <emmintrin.h>
+#endif
+#endif
 
 #ifndef LEPT_PARSE_STACK_INIT_SIZE
 #define LEPT_PARSE_STACK_INIT_SIZE 256
@@ -18,18 +42,194 @@
 #define LEPT_PARSE_STRINGIFY_INIT_SIZE 256
 #endif
 
-#define EXPECT(c, ch)       do { assert(*c->json == (ch)); c->json++; } while(0)
+#ifndef LEPT_ARENA_BLOCK_SIZE
+#define LEPT_ARENA_BLOCK_SIZE 4096
+#endif
+
+#ifndef LEPT_OBJECT_INDEX_MIN_SIZE
+#define LEPT_OBJECT_INDEX_MIN_SIZE 16
+#endif
+
+#ifndef LEPT_PARSE_MAX_DEPTH
+#define LEPT_PARSE_MAX_DEPTH 1000
+#endif
+
+#ifndef LEPT_PARSE_ENGINE
+#define LEPT_PARSE_ENGINE LEPT_ENGINE_RECURSIVE
+#endif
+
+#define EXPECT(c, ch)       do { assert(c->json != c->end && *c->json == (ch)); c->json++; } while(0)
+#define PEEK(c)             ((c)->json != (c)->end ? *(c)->json : '\0')
 #define ISDIGIT(ch)         ((ch) >= '0' && (ch) <= '9')
 #define ISDIGIT1TO9(ch)     ((ch) >= '1' && (ch) <= '9')
+#define ISWHITESPACE(ch)    ((ch) == ' ' || (ch) == '\t' || (ch) == '\n' || (ch) == '\r')
 #define PUTC(c, ch)         do { *(char*)lept_context_push(c, sizeof(char)) = (ch); } while(0)
 #define PUTS(c, s, len)     memcpy(lept_context_push(c, len), s, len)
+#define WRITEC(w, ch)       do { if ((w)->top == (w)->size) lept_writer_flush(w, 1); (w)->buf[(w)->top++] = (ch); } while(0)
+
+#define LEPT_UINT64_C2(high32, low32) (((lept_uint64)(high32) << 32) | (lept_uint64)(low32))
+
+#define LEPT_BORROWED_DATA  0x1 /* string/element/member buffer is not owned (arena, in situ) */
+#define LEPT_BORROWED_KEYS  0x2 /* member keys are not owned (arena, in situ) */
+#define LEPT_OBJECT_INDEXED 0x4 /* a key hash index follows the capacity members */
+#define LEPT_SHORT_STRING   0x8 /* string is stored in u.ss */
+#define LEPT_LAZY           0x10 /* array/object not parsed yet: u.l holds its text */
+#define LEPT_BORROWED_TEXT  0x20 /* array/object with strings or keys below it in in situ text */
+
+#ifdef LEPT_COMPACT
+/* sizes and lengths live outside the union, capacities in the block header */
+#define LEPT_ARRAY_SIZE(v)              ((v)->size)
+#define LEPT_OBJECT_SIZE(v)             ((v)->size)
+#define LEPT_ARRAY_CAPACITY(v)          ((v)->u.a.e ? (size_t)LEPT_CAPACITY((v)->u.a.e) : 0)
+#define LEPT_OBJECT_CAPACITY(v)         ((v)->u.o.m ? (size_t)LEPT_CAPACITY((v)->u.o.m) : 0)
+#define LEPT_SET_ARRAY_CAPACITY(v, n)   do { if ((v)->u.a.e) LEPT_CAPACITY((v)->u.a.e) = (lept_size)(n); } while(0)
+#define LEPT_SET_OBJECT_CAPACITY(v, n)  do { if ((v)->u.o.m) LEPT_CAPACITY((v)->u.o.m) = (lept_size)(n); } while(0)
+#define LEPT_LONG_STRING_LENGTH(v)      ((v)->size)
+#define LEPT_SHORT_STRING_LENGTH(v)     ((v)->size)
+#define LEPT_STRING_LENGTH(v)           ((size_t)(v)->size)
+#define LEPT_LAZY_LENGTH(v)             ((v)->size)
+#else
+#define LEPT_ARRAY_SIZE(v)              ((v)->u.a.size)
+#define LEPT_OBJECT_SIZE(v)             ((v)->u.o.size)
+#define LEPT_ARRAY_CAPACITY(v)          ((v)->u.a.capacity)
+#define LEPT_OBJECT_CAPACITY(v)         ((v)->u.o.capacity)
+#define LEPT_SET_ARRAY_CAPACITY(v, n)   do { (v)->u.a.capacity = (n); } while(0)
+#define LEPT_SET_OBJECT_CAPACITY(v, n)  do { (v)->u.o.capacity = (n); } while(0)
+#define LEPT_LONG_STRING_LENGTH(v)      ((v)->u.s.len)
+#define LEPT_SHORT_STRING_LENGTH(v)     ((v)->u.ss.len)
+#define LEPT_STRING_LENGTH(v)           ((v)->flags & LEPT_SHORT_STRING ? (size_t)(v)->u.ss.len : (v)->u.s.len)
+#define LEPT_LAZY_LENGTH(v)             ((v)->u.l.len)
+#endif
+
+#define LEPT_STRING_DATA(v)   ((v)->flags & LEPT_SHORT_STRING ? (v)->u.ss.s : (v)->u.s.s)
+
+#define LEPT_OBJECT_INDEX(v) ((size_t*)((v)->u.o.m + LEPT_OBJECT_CAPACITY(v)))
+
+struct lept_arena_block {
+    lept_arena_block* next;
+    size_t size;
+};
+
+typedef union { double d; void* p; size_t s; } lept_arena_align;
+
+#define LEPT_ARENA_ALIGN(n) (((n) + sizeof(lept_arena_align) - 1) / sizeof(lept_arena_align) * sizeof(lept_arena_align))
+#define LEPT_ARENA_DATA(b)  ((char*)(b) + LEPT_ARENA_ALIGN(sizeof(lept_arena_block)))
 
 typedef struct {
-    const char* json;
+    const char* json, *end;
     char* stack;
     size_t size, top;
+    lept_arena* arena;
+    int insitu;
+    const lept_handler* handler;
+    void* user;
+    size_t depth, max_depth;
+    int engine;
+    int lazy;   /* LEPT_LAZY_*, or 0 to parse everything */
 }lept_context;
 
+/* how lazy parsing records arrays and objects below the root */
+enum {
+    LEPT_LAZY_CHECK = 1,    /* parse them without building anything, to report errors now */
+    LEPT_LAZY_SKIP          /* skip them by balancing brackets: the text is known to be valid */
+};
+
+static void* lept_arena_alloc(lept_arena* a, size_t size) {
+    void* ret;
+    size = LEPT_ARENA_ALIGN(size);
+    if (a->head == NULL || a->used + size > a->head->size) {
+        lept_arena_block* b;
+        size_t bsize = a->head ? a->head->size * 2 : LEPT_ARENA_BLOCK_SIZE;
+        while (bsize < size)
+            bsize *= 2;
+        b = (lept_arena_block*)malloc(LEPT_ARENA_ALIGN(sizeof(lept_arena_block)) + bsize);
+        b->next = a->head;
+        b->size = bsize;
+        a->head = b;
+        a->used = 0;
+    }
+    ret = LEPT_ARENA_DATA(a->head) + a->used;
+    a->used += size;
+    return ret;
+}
+
+void lept_arena_reset(lept_arena* a) {
+    lept_arena_block* b;
+    assert(a != NULL);
+    if (a->head) {
+        /* keep only the newest block, which is also the largest */
+        for (b = a->head->next; b != NULL; ) {
+            lept_arena_block* next = b->next;
+            free(b);
+            b = next;
+        }
+        a->head->next = NULL;
+    }
+    a->used = 0;
+}
+
+void lept_arena_destroy(lept_arena* a) {
+    lept_arena_reset(a);
+    free(a->head);
+    a->head = NULL;
+}
+
+/* Heap storage of values (strings, keys, elements and members) starts with a reference
+   count, so that lept_share() can hand it to several values. */
+#ifdef LEPT_COMPACT
+#define LEPT_BLOCK_HEADER   LEPT_ARENA_ALIGN(2 * sizeof(lept_size))
+#define LEPT_REFCOUNT(p)    (((lept_size*)((char*)(p) - LEPT_BLOCK_HEADER))[0])
+#define LEPT_CAPACITY(p)    (((lept_size*)((char*)(p) - LEPT_BLOCK_HEADER))[1]) /* of element/member blocks */
+#else
+#define LEPT_BLOCK_HEADER   LEPT_ARENA_ALIGN(sizeof(size_t))
+#define LEPT_REFCOUNT(p)    (*(size_t*)((char*)(p) - LEPT_BLOCK_HEADER))
+#endif
+
+static void* lept_block_alloc(size_t size) {
+    char* p = (char*)malloc(LEPT_BLOCK_HEADER + size) + LEPT_BLOCK_HEADER;
+    LEPT_REFCOUNT(p) = 1;
+#ifdef LEPT_COMPACT
+    LEPT_CAPACITY(p) = 0;
+#endif
+    return p;
+}
+
+static void* lept_block_realloc(void* p, size_t size) {
+    if (p == NULL)
+        return lept_block_alloc(size);
+    assert(LEPT_REFCOUNT(p) == 1);
+    return (char*)realloc((char*)p - LEPT_BLOCK_HEADER, LEPT_BLOCK_HEADER + size) + LEPT_BLOCK_HEADER;
+}
+
+/* Drops a reference and returns nonzero for the last one: the caller then frees what the
+   block owns, and the block with lept_block_free(). */
+static int lept_block_release(void* p) {
+    return p != NULL && --LEPT_REFCOUNT(p) == 0;
+}
+
+static void lept_block_free(void* p) {
+    free((char*)p - LEPT_BLOCK_HEADER);
+}
+
+static void* lept_context_alloc(lept_context* c, size_t size) {
+#ifdef LEPT_COMPACT
+    /* arena containers keep their capacity in a header too */
+    if (c->arena)
+        return (char*)lept_arena_alloc(c->arena, LEPT_BLOCK_HEADER + size) + LEPT_BLOCK_HEADER;
+#endif
+    return c->arena ? lept_arena_alloc(c->arena, size) : lept_block_alloc(size);
+}
+
+static char* lept_context_strdup(lept_context* c, const char* s, size_t len) {
+    char* ret;
+    if (c->insitu)
+        return (char*)s; /* already unescaped and terminated in place */
+    ret = (char*)lept_context_alloc(c, len + 1);
+    memcpy(ret, s, len);
+    ret[len] = '\0';
+    return ret;
+}
+
 static void* lept_context_push(lept_context* c, size_t size) {
     void* ret;
     assert(size > 0);
@@ -50,54 +250,1148 @@ static void* lept_context_pop(lept_context* c, size_t size) {
     return c->stack + (c->top -= size);
 }
 
+#if defined(LEPT_SSE2)
+static unsigned lept_ctz(unsigned mask) {
+#if defined(_MSC_VER)
+    unsigned long i;
+    _BitScanForward(&i, mask);
+    return (unsigned)i;
+#elif defined(__GNUC__)
+    return (unsigned)__builtin_ctz(mask);
+#else
+    unsigned i;
+    for (i = 0; !(mask & 1); i++)
+        mask >>= 1;
+    return i;
+#endif
+}
+#endif
+
+/* Returns the first '"', '\\' or control character in [p, end), or end. */
+static const char* lept_scan_string(const char* p, const char* end) {
+#if defined(LEPT_AVX2)
+    const __m256i quote32 = _mm256_set1_epi8('\"'), backslash32 = _mm256_set1_epi8('\\'), control32 = _mm256_set1_epi8(0x1F);
+#endif
+#if defined(LEPT_SSE2)
+    const __m128i quote16 = _mm_set1_epi8('\"'), backslash16 = _mm_set1_epi8('\\'), control16 = _mm_set1_epi8(0x1F);
+#endif
+#if defined(LEPT_AVX2)
+    for (; end - p >= 32; p += 32) {
+        __m256i s = _mm256_loadu_si256((const __m256i*)p);
+        __m256i x = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(s, quote32), _mm256_cmpeq_epi8(s, backslash32)),
+            _mm256_cmpeq_epi8(_mm256_max_epu8(s, control32), control32)); /* s <= 0x1F */
+        unsigned mask = (unsigned)_mm256_movemask_epi8(x);
+        if (mask != 0)
+            return p + lept_ctz(mask);
+    }
+#endif
+#if defined(LEPT_SSE2)
+    for (; end - p >= 16; p += 16) {
+        __m128i s = _mm_loadu_si128((const __m128i*)p);
+        __m128i x = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(s, quote16), _mm_cmpeq_epi8(s, backslash16)),
+            _mm_cmpeq_epi8(_mm_max_epu8(s, control16), control16));
+        unsigned mask = (unsigned)_mm_movemask_epi8(x);
+        if (mask != 0)
+            return p + lept_ctz(mask);
+    }
+#endif
+    while (p != end && *p != '\"' && *p != '\\' && (unsigned char)*p >= 0x20)
+        p++;
+    return p;
+}
+
+/* Returns the first non-whitespace character in [p, end), or end. */
+static const char* lept_scan_whitespace(const char* p, const char* end) {
+#if defined(LEPT_AVX2)
+    const __m256i space32 = _mm256_set1_epi8(' '), tab32 = _mm256_set1_epi8('\t'), lf32 = _mm256_set1_epi8('\n'), cr32 = _mm256_set1_epi8('\r');
+#endif
+#if defined(LEPT_SSE2)
+    const __m128i space16 = _mm_set1_epi8(' '), tab16 = _mm_set1_epi8('\t'), lf16 = _mm_set1_epi8('\n'), cr16 = _mm_set1_epi8('\r');
+#endif
+#if defined(LEPT_AVX2)
+    for (; end - p >= 32; p += 32) {
+        __m256i s = _mm256_loadu_si256((const __m256i*)p);
+        __m256i x = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(s, space32), _mm256_cmpeq_epi8(s, tab32)),
+            _mm256_or_si256(_mm256_cmpeq_epi8(s, lf32), _mm256_cmpeq_epi8(s, cr32)));
+        unsigned mask = ~(unsigned)_mm256_movemask_epi8(x);
+        if (mask != 0)
+            return p + lept_ctz(mask);
+    }
+#endif
+#if defined(LEPT_SSE2)
+    for (; end - p >= 16; p += 16) {
+        __m128i s = _mm_loadu_si128((const __m128i*)p);
+        __m128i x = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(s, space16), _mm_cmpeq_epi8(s, tab16)),
+            _mm_or_si128(_mm_cmpeq_epi8(s, lf16), _mm_cmpeq_epi8(s, cr16)));
+        unsigned mask = ~(unsigned)_mm_movemask_epi8(x) & 0xFFFF;
+        if (mask != 0)
+            return p + lept_ctz(mask);
+    }
+#endif
+    while (p != end && ISWHITESPACE(*p))
+        p++;
+    return p;
+}
+
+/* Stage 1 of the indexed engine classifies the input 64 bytes at a time, one bit per byte,
+   and turns the bitmaps into the offsets of all tokens: structural characters and opening
+   quotes outside strings, and the first character of every other scalar (or of garbage). */
+
+#define LEPT_EVEN_BITS LEPT_UINT64_C2(0x55555555, 0x55555555)
+
+typedef struct {
+    lept_uint64 quote, backslash, space, op;   /* '"', '\\', whitespace, one of "{}[]:," */
+}lept_block_bits;
+
+static void lept_classify_block(const char* p, lept_block_bits* b) {
+#if defined(LEPT_AVX2)
+    const __m256i quote32 = _mm256_set1_epi8('\"'), backslash32 = _mm256_set1_epi8('\\'), case32 = _mm256_set1_epi8(0x20);
+    const __m256i space32 = _mm256_set1_epi8(' '), tab32 = _mm256_set1_epi8('\t'), lf32 = _mm256_set1_epi8('\n'), cr32 = _mm256_set1_epi8('\r');
+    const __m256i lbrace32 = _mm256_set1_epi8('{'), rbrace32 = _mm256_set1_epi8('}'), colon32 = _mm256_set1_epi8(':'), comma32 = _mm256_set1_epi8(',');
+    int i;
+    b->quote = b->backslash = b->space = b->op = 0;
+    for (i = 0; i < 64; i += 32) {
+        __m256i s = _mm256_loadu_si256((const __m256i*)(p + i));
+        __m256i l = _mm256_or_si256(s, case32); /* '[' and ']' become '{' and '}' */
+        b->quote |= (lept_uint64)(unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(s, quote32)) << i;
+        b->backslash |= (lept_uint64)(unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(s, backslash32)) << i;
+        b->space |= (lept_uint64)(unsigned)_mm256_movemask_epi8(_mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(s, space32), _mm256_cmpeq_epi8(s, tab32)),
+            _mm256_or_si256(_mm256_cmpeq_epi8(s, lf32), _mm256_cmpeq_epi8(s, cr32)))) << i;
+        b->op |= (lept_uint64)(unsigned)_mm256_movemask_epi8(_mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(l, lbrace32), _mm256_cmpeq_epi8(l, rbrace32)),
+            _mm256_or_si256(_mm256_cmpeq_epi8(s, colon32), _mm256_cmpeq_epi8(s, comma32)))) << i;
+    }
+#elif defined(LEPT_SSE2)
+    const __m128i quote16 = _mm_set1_epi8('\"'), backslash16 = _mm_set1_epi8('\\'), case16 = _mm_set1_epi8(0x20);
+    const __m128i space16 = _mm_set1_epi8(' '), tab16 = _mm_set1_epi8('\t'), lf16 = _mm_set1_epi8('\n'), cr16 = _mm_set1_epi8('\r');
+    const __m128i lbrace16 = _mm_set1_epi8('{'), rbrace16 = _mm_set1_epi8('}'), colon16 = _mm_set1_epi8(':'), comma16 = _mm_set1_epi8(',');
+    int i;
+    b->quote = b->backslash = b->space = b->op = 0;
+    for (i = 0; i < 64; i += 16) {
+        __m128i s = _mm_loadu_si128((const __m128i*)(p + i));
+        __m128i l = _mm_or_si128(s, case16);
+        b->quote |= (lept_uint64)(unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(s, quote16)) << i;
+        b->backslash |= (lept_uint64)(unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(s, backslash16)) << i;
+        b->space |= (lept_uint64)(unsigned)_mm_movemask_epi8(_mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(s, space16), _mm_cmpeq_epi8(s, tab16)),
+            _mm_or_si128(_mm_cmpeq_epi8(s, lf16), _mm_cmpeq_epi8(s, cr16)))) << i;
+        b->op |= (lept_uint64)(unsigned)_mm_movemask_epi8(_mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(l, lbrace16), _mm_cmpeq_epi8(l, rbrace16)),
+            _mm_or_si128(_mm_cmpeq_epi8(s, colon16), _mm_cmpeq_epi8(s, comma16)))) << i;
+    }
+#else
+    int i;
+    b->quote = b->backslash = b->space = b->op = 0;
+    for (i = 0; i < 64; i++) {
+        lept_uint64 bit = (lept_uint64)1 << i;
+        switch (p[i]) {
+            case '\"':  b->quote |= bit; break;
+            case '\\': b->backslash |= bit; break;
+            case ' ': case '\t': case '\n': case '\r': b->space |= bit; break;
+            case '{': case '}': case '[': case ']': case ':': case ',': b->op |= bit; break;
+        }
+    }
+#endif
+}
+
+/* Characters escaped by an odd run of backslashes; *odd carries a run across blocks. */
+static lept_uint64 lept_escaped_bits(lept_uint64 bs, lept_uint64* odd) {
+    lept_uint64 starts = bs & ~(bs << 1);
+    lept_uint64 even_start_mask = LEPT_EVEN_BITS ^ *odd;
+    lept_uint64 even_carries = bs + (starts & even_start_mask);
+    lept_uint64 odd_carries = bs + (starts & ~even_start_mask);
+    lept_uint64 carry = odd_carries < bs; /* a run starting at an odd bit goes on in the next block */
+    odd_carries |= *odd;
+    *odd = carry;
+    return (even_carries & ~bs & ~LEPT_EVEN_BITS) | (odd_carries & ~bs & LEPT_EVEN_BITS);
+}
+
+/* Sets every bit from an unescaped quote up to (not including) the next one. */
+static lept_uint64 lept_prefix_xor(lept_uint64 x) {
+    x ^= x << 1;
+    x ^= x << 2;
+    x ^= x << 4;
+    x ^= x << 8;
+    x ^= x << 16;
+    x ^= x << 32;
+    return x;
+}
+
+static unsigned lept_ctz64(lept_uint64 mask) {
+#if defined(_MSC_VER) && defined(_M_X64)
+    unsigned long i;
+    _BitScanForward64(&i, mask);
+    return (unsigned)i;
+#elif defined(__GNUC__)
+    return (unsigned)__builtin_ctzll(mask);
+#else
+    unsigned i;
+    for (i = 0; !(mask & 1); i++)
+        mask >>= 1;
+    return i;
+#endif
+}
+
+/* Returns the offsets of the tokens of json in a malloc()ed array of *count. */
+static size_t* lept_index_tokens(const char* json, size_t len, size_t* count) {
+    lept_uint64 odd = 0, in_string = 0, pred = 1; /* the document starts as if after whitespace */
+    size_t i, n = 0, capacity = len / 8 + 64;
+    size_t* tokens = (size_t*)malloc(capacity * sizeof(size_t));
+    char last[64];
+    for (i = 0; i < len; i += 64) {
+        lept_block_bits b;
+        lept_uint64 quote, string, found, after;
+        if (len - i >= 64)
+            lept_classify_block(json + i, &b);
+        else {
+            memset(last, ' ', sizeof(last));
+            memcpy(last, json + i, len - i);
+            lept_classify_block(last, &b);
+        }
+        quote = b.quote & ~lept_escaped_bits(b.backslash, &odd);
+        string = lept_prefix_xor(quote) ^ in_string; /* opening quotes are inside, closing ones outside */
+        in_string = (lept_uint64)0 - (string >> 63);
+        found = (b.op & ~string) | quote;
+        /* non-whitespace after whitespace, a structural character or a quote starts a token */
+        after = found | b.space;
+        found |= ((after << 1) | pred) & ~b.space & ~string;
+        pred = after >> 63;
+        found &= ~(quote & ~string); /* but closing quotes are not tokens themselves */
+        if (capacity - n < 64) {
+            capacity += capacity >> 1;
+            tokens = (size_t*)realloc(tokens, capacity * sizeof(size_t));
+        }
+        for (; found != 0; found &= found - 1)
+            tokens[n++] = i + lept_ctz64(found);
+    }
+    *count = n;
+    return tokens;
+}
+
+static size_t lept_hash_key(const char* key, size_t klen) {
+    size_t i, h = 2166136261u; /* FNV-1a */
+    for (i = 0; i < klen; i++)
+        h = (h ^ (unsigned char)key[i]) * 16777619u;
+    return h;
+}
+
+/* Open addressing slots holding member index + 1, at most half full. */
+static size_t lept_object_index_size(size_t capacity) {
+    size_t n = 1;
+    while (n < capacity * 2)
+        n <<= 1;
+    return n;
+}
+
+static void lept_object_index_add(lept_value* v, size_t i) {
+    size_t mask = lept_object_index_size(LEPT_OBJECT_CAPACITY(v)) - 1;
+    size_t* index = LEPT_OBJECT_INDEX(v);
+    size_t h = lept_hash_key(v->u.o.m[i].k, v->u.o.m[i].klen) & mask;
+    while (index[h])
+        h = (h + 1) & mask;
+    index[h] = i + 1;
+}
+
+/* Fills the index of an object whose member block has room for it. */
+static void lept_object_index_fill(lept_value* v) {
+    size_t i;
+    memset(LEPT_OBJECT_INDEX(v), 0, lept_object_index_size(LEPT_OBJECT_CAPACITY(v)) * sizeof(size_t));
+    for (i = 0; i < LEPT_OBJECT_SIZE(v); i++)
+        lept_object_index_add(v, i);
+    v->flags |= LEPT_OBJECT_INDEXED;
+}
+
+static size_t* lept_object_index_slot(lept_value* v, size_t i) {
+    size_t mask = lept_object_index_size(LEPT_OBJECT_CAPACITY(v)) - 1;
+    size_t* index = LEPT_OBJECT_INDEX(v);
+    size_t h = lept_hash_key(v->u.o.m[i].k, v->u.o.m[i].klen) & mask;
+    while (index[h] != i + 1) {
+        assert(index[h] != 0);
+        h = (h + 1) & mask;
+    }
+    return &index[h];
+}
+
+/* Removes member i, whose key is still in place, shifting later entries of its probe run back. */
+static void lept_object_index_remove(lept_value* v, size_t i) {
+    size_t mask = lept_object_index_size(LEPT_OBJECT_CAPACITY(v)) - 1;
+    size_t* index = LEPT_OBJECT_INDEX(v);
+    size_t j = lept_object_index_slot(v, i) - index, k, h;
+    index[j] = 0;
+    for (k = (j + 1) & mask; index[k]; k = (k + 1) & mask) {
+        h = lept_hash_key(v->u.o.m[index[k] - 1].k, v->u.o.m[index[k] - 1].klen) & mask;
+        /* an entry may fill the hole unless its home slot lies cyclically in (j, k] */
+        if (j < k ? (h <= j || h > k) : (h <= j && h > k)) {
+            index[j] = index[k];
+            index[k] = 0;
+            j = k;
+        }
+    }
+}
+
 static void lept_parse_whitespace(lept_context* c) {
     const char *p = c->json;
-    while (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r')
-        p++;
-    c->json = p;
+    /* Compact input has no whitespace here, pretty-printed input mostly a single
+       space or a newline followed by indentation: only go wide for the latter. */
+    if (p == c->end || !ISWHITESPACE(*p))
+        return;
+    if (++p == c->end || !ISWHITESPACE(*p)) {
+        c->json = p;
+        return;
+    }
+    c->json = lept_scan_whitespace(p, c->end);
 }
 
-static int lept_parse_literal(lept_context* c, lept_value* v, const char* literal, lept_type type) {
+static int lept_parse_literal(lept_context* c, const char* literal, lept_type type) {
     size_t i;
     EXPECT(c, literal[0]);
     for (i = 0; literal[i + 1]; i++)
-        if (c->json[i] != literal[i + 1])
+        if (c->json + i == c->end || c->json[i] != literal[i + 1])
             return LEPT_PARSE_INVALID_VALUE;
     c->json += i;
-    v->type = type;
-    return LEPT_PARSE_OK;
+    if (type == LEPT_NULL)
+        return c->handler->on_null(c->user);
+    return c->handler->on_bool(c->user, type == LEPT_TRUE);
+}
+
+#define LEPT_DP_SIGN_MASK           LEPT_UINT64_C2(0x80000000, 0x00000000)
+#define LEPT_DP_EXPONENT_MASK       LEPT_UINT64_C2(0x7FF00000, 0x00000000)
+#define LEPT_DP_SIGNIFICAND_MASK    LEPT_UINT64_C2(0x000FFFFF, 0xFFFFFFFF)
+#define LEPT_DP_HIDDEN_BIT          LEPT_UINT64_C2(0x00100000, 0x00000000)
+#define LEPT_DP_EXPONENT_BIAS       (0x3FF + 52)
+
+#define NUMC(p)             ((p) != c->end ? *(p) : '\0')
+/* accumulates up to 19 significant digits; dropped integer digits still scale e10 */
+#define NUMD(p, frac)       do { if (m < LEPT_UINT64_C2(0x0de0b6b3, 0xa7640000)) { m = m * 10 + (unsigned)(*(p) - '0'); e10 -= (frac); }\
+                                 else { truncated |= *(p) != '0'; e10 += !(frac); } } while(0)
+
+static const double lept_pow10[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/* Clinger's fast path: m * 10^e10 is correctly rounded by a single multiplication
+   or division when both m and the power of ten are exact doubles. */
+static int lept_fast_number(double m, int e10, double* d) {
+#if defined(__i386__) && !defined(__SSE2_MATH__)
+    return 0; /* x87 extended precision would round twice */
+#else
+    if (m == 0.0)
+        *d = 0.0;
+    else if (e10 < -22)
+        return 0;
+    else if (e10 < 0)
+        *d = m / lept_pow10[-e10];
+    else if (e10 <= 22)
+        *d = m * lept_pow10[e10];
+    else if (e10 <= 22 + 15 && (m *= lept_pow10[e10 - 22]) < 9007199254740992.0) /* e.g. 1e23 */
+        *d = m * lept_pow10[22];
+    else
+        return 0;
+    return 1;
+#endif
+}
+
+static const lept_uint64 lept_pow5_128[] = { /* 5^-342, ..., 5^308 normalized to 128 bits, high then low word */
+    LEPT_UINT64_C2(0xeef453d6, 0x923bd65a), LEPT_UINT64_C2(0x113faa29, 0x06a13b3f),
+    LEPT_UINT64_C2(0x9558b466, 0x1b6565f8), LEPT_UINT64_C2(0x4ac7ca59, 0xa424c507),
+    LEPT_UINT64_C2(0xbaaee17f, 0xa23ebf76), LEPT_UINT64_C2(0x5d79bcf0, 0x0d2df649),
+    LEPT_UINT64_C2(0xe95a99df, 0x8ace6f53), LEPT_UINT64_C2(0xf4d82c2c, 0x107973dc),
+    LEPT_UINT64_C2(0x91d8a02b, 0xb6c10594), LEPT_UINT64_C2(0x79071b9b, 0x8a4be869),
+    LEPT_UINT64_C2(0xb64ec836, 0xa47146f9), LEPT_UINT64_C2(0x9748e282, 0x6cdee284),
+    LEPT_UINT64_C2(0xe3e27a44, 0x4d8d98b7), LEPT_UINT64_C2(0xfd1b1b23, 0x08169b25),
+    LEPT_UINT64_C2(0x8e6d8c6a, 0xb0787f72), LEPT_UINT64_C2(0xfe30f0f5, 0xe50e20f7),
+    LEPT_UINT64_C2(0xb208ef85, 0x5c969f4f), LEPT_UINT64_C2(0xbdbd2d33, 0x5e51a935),
+    LEPT_UINT64_C2(0xde8b2b66, 0xb3bc4723), LEPT_UINT64_C2(0xad2c7880, 0x35e61382),
+    LEPT_UINT64_C2(0x8b16fb20, 0x3055ac76), LEPT_UINT64_C2(0x4c3bcb50, 0x21afcc31),
+    LEPT_UINT64_C2(0xaddcb9e8, 0x3c6b1793), LEPT_UINT64_C2(0xdf4abe24, 0x2a1bbf3d),
+    LEPT_UINT64_C2(0xd953e862, 0x4b85dd78), LEPT_UINT64_C2(0xd71d6dad, 0x34a2af0d),
+    LEPT_UINT64_C2(0x87d4713d, 0x6f33aa6b), LEPT_UINT64_C2(0x8672648c, 0x40e5ad68),
+    LEPT_UINT64_C2(0xa9c98d8c, 0xcb009506), LEPT_UINT64_C2(0x680efdaf, 0x511f18c2),
+    LEPT_UINT64_C2(0xd43bf0ef, 0xfdc0ba48), LEPT_UINT64_C2(0x0212bd1b, 0x2566def2),
+    LEPT_UINT64_C2(0x84a57695, 0xfe98746d), LEPT_UINT64_C2(0x014bb630, 0xf7604b57),
+    LEPT_UINT64_C2(0xa5ced43b, 0x7e3e9188), LEPT_UINT64_C2(0x419ea3bd, 0x35385e2d),
+    LEPT_UINT64_C2(0xcf42894a, 0x5dce35ea), LEPT_UINT64_C2(0x52064cac, 0x828675b9),
+    LEPT_UINT64_C2(0x818995ce, 0x7aa0e1b2), LEPT_UINT64_C2(0x7343efeb, 0xd1940993),
+    LEPT_UINT64_C2(0xa1ebfb42, 0x19491a1f), LEPT_UINT64_C2(0x1014ebe6, 0xc5f90bf8),
+    LEPT_UINT64_C2(0xca66fa12, 0x9f9b60a6), LEPT_UINT64_C2(0xd41a26e0, 0x77774ef6),
+    LEPT_UINT64_C2(0xfd00b897, 0x478238d0), LEPT_UINT64_C2(0x8920b098, 0x955522b4),
+    LEPT_UINT64_C2(0x9e20735e, 0x8cb16382), LEPT_UINT64_C2(0x55b46e5f, 0x5d5535b0),
+    LEPT_UINT64_C2(0xc5a89036, 0x2fddbc62), LEPT_UINT64_C2(0xeb2189f7, 0x34aa831d),
+    LEPT_UINT64_C2(0xf712b443, 0xbbd52b7b), LEPT_UINT64_C2(0xa5e9ec75, 0x01d523e4),
+    LEPT_UINT64_C2(0x9a6bb0aa, 0x55653b2d), LEPT_UINT64_C2(0x47b233c9, 0x2125366e),
+    LEPT_UINT64_C2(0xc1069cd4, 0xeabe89f8), LEPT_UINT64_C2(0x999ec0bb, 0x696e840a),
+    LEPT_UINT64_C2(0xf148440a, 0x256e2c76), LEPT_UINT64_C2(0xc00670ea, 0x43ca250d),
+    LEPT_UINT64_C2(0x96cd2a86, 0x5764dbca), LEPT_UINT64_C2(0x38040692, 0x6a5e5728),
+    LEPT_UINT64_C2(0xbc807527, 0xed3e12bc), LEPT_UINT64_C2(0xc6050837, 0x04f5ecf2),
+    LEPT_UINT64_C2(0xeba09271, 0xe88d976b), LEPT_UINT64_C2(0xf7864a44, 0xc633682e),
+    LEPT_UINT64_C2(0x93445b87, 0x31587ea3), LEPT_UINT64_C2(0x7ab3ee6a, 0xfbe0211d),
+    LEPT_UINT64_C2(0xb8157268, 0xfdae9e4c), LEPT_UINT64_C2(0x5960ea05, 0xbad82964),
+    LEPT_UINT64_C2(0xe61acf03, 0x3d1a45df), LEPT_UINT64_C2(0x6fb92487, 0x298e33bd),
+    LEPT_UINT64_C2(0x8fd0c162, 0x06306bab), LEPT_UINT64_C2(0xa5d3b6d4, 0x79f8e056),
+    LEPT_UINT64_C2(0xb3c4f1ba, 0x87bc8696), LEPT_UINT64_C2(0x8f48a489, 0x9877186c),
+    LEPT_UINT64_C2(0xe0b62e29, 0x29aba83c), LEPT_UINT64_C2(0x331acdab, 0xfe94de87),
+    LEPT_UINT64_C2(0x8c71dcd9, 0xba0b4925), LEPT_UINT64_C2(0x9ff0c08b, 0x7f1d0b14),
+    LEPT_UINT64_C2(0xaf8e5410, 0x288e1b6f), LEPT_UINT64_C2(0x07ecf0ae, 0x5ee44dd9),
+    LEPT_UINT64_C2(0xdb71e914, 0x32b1a24a), LEPT_UINT64_C2(0xc9e82cd9, 0xf69d6150),
+    LEPT_UINT64_C2(0x892731ac, 0x9faf056e), LEPT_UINT64_C2(0xbe311c08, 0x3a225cd2),
+    LEPT_UINT64_C2(0xab70fe17, 0xc79ac6ca), LEPT_UINT64_C2(0x6dbd630a, 0x48aaf406),
+    LEPT_UINT64_C2(0xd64d3d9d, 0xb981787d), LEPT_UINT64_C2(0x092cbbcc, 0xdad5b108),
+    LEPT_UINT64_C2(0x85f04682, 0x93f0eb4e), LEPT_UINT64_C2(0x25bbf560, 0x08c58ea5),
+    LEPT_UINT64_C2(0xa76c5823, 0x38ed2621), LEPT_UINT64_C2(0xaf2af2b8, 0x0af6f24e),
+    LEPT_UINT64_C2(0xd1476e2c, 0x07286faa), LEPT_UINT64_C2(0x1af5af66, 0x0db4aee1),
+    LEPT_UINT64_C2(0x82cca4db, 0x847945ca), LEPT_UINT64_C2(0x50d98d9f, 0xc890ed4d),
+    LEPT_UINT64_C2(0xa37fce12, 0x6597973c), LEPT_UINT64_C2(0xe50ff107, 0xbab528a0),
+    LEPT_UINT64_C2(0xcc5fc196, 0xfefd7d0c), LEPT_UINT64_C2(0x1e53ed49, 0xa96272c8),
+    LEPT_UINT64_C2(0xff77b1fc, 0xbebcdc4f), LEPT_UINT64_C2(0x25e8e89c, 0x13bb0f7a),
+    LEPT_UINT64_C2(0x9faacf3d, 0xf73609b1), LEPT_UINT64_C2(0x77b19161, 0x8c54e9ac),
+    LEPT_UINT64_C2(0xc795830d, 0x75038c1d), LEPT_UINT64_C2(0xd59df5b9, 0xef6a2417),
+    LEPT_UINT64_C2(0xf97ae3d0, 0xd2446f25), LEPT_UINT64_C2(0x4b057328, 0x6b44ad1d),
+    LEPT_UINT64_C2(0x9becce62, 0x836ac577), LEPT_UINT64_C2(0x4ee367f9, 0x430aec32),
+    LEPT_UINT64_C2(0xc2e801fb, 0x244576d5), LEPT_UINT64_C2(0x229c41f7, 0x93cda73f),
+    LEPT_UINT64_C2(0xf3a20279, 0xed56d48a), LEPT_UINT64_C2(0x6b435275, 0x78c1110f),
+    LEPT_UINT64_C2(0x9845418c, 0x345644d6), LEPT_UINT64_C2(0x830a1389, 0x6b78aaa9),
+    LEPT_UINT64_C2(0xbe5691ef, 0x416bd60c), LEPT_UINT64_C2(0x23cc986b, 0xc656d553),
+    LEPT_UINT64_C2(0xedec366b, 0x11c6cb8f), LEPT_UINT64_C2(0x2cbfbe86, 0xb7ec8aa8),
+    LEPT_UINT64_C2(0x94b3a202, 0xeb1c3f39), LEPT_UINT64_C2(0x7bf7d714, 0x32f3d6a9),
+    LEPT_UINT64_C2(0xb9e08a83, 0xa5e34f07), LEPT_UINT64_C2(0xdaf5ccd9, 0x3fb0cc53),
+    LEPT_UINT64_C2(0xe858ad24, 0x8f5c22c9), LEPT_UINT64_C2(0xd1b3400f, 0x8f9cff68),
+    LEPT_UINT64_C2(0x91376c36, 0xd99995be), LEPT_UINT64_C2(0x23100809, 0xb9c21fa1),
+    LEPT_UINT64_C2(0xb5854744, 0x8ffffb2d), LEPT_UINT64_C2(0xabd40a0c, 0x2832a78a),
+    LEPT_UINT64_C2(0xe2e69915, 0xb3fff9f9), LEPT_UINT64_C2(0x16c90c8f, 0x323f516c),
+    LEPT_UINT64_C2(0x8dd01fad, 0x907ffc3b), LEPT_UINT64_C2(0xae3da7d9, 0x7f6792e3),
+    LEPT_UINT64_C2(0xb1442798, 0xf49ffb4a), LEPT_UINT64_C2(0x99cd11cf, 0xdf41779c),
+    LEPT_UINT64_C2(0xdd95317f, 0x31c7fa1d), LEPT_UINT64_C2(0x40405643, 0xd711d583),
+    LEPT_UINT64_C2(0x8a7d3eef, 0x7f1cfc52), LEPT_UINT64_C2(0x482835ea, 0x666b2572),
+    LEPT_UINT64_C2(0xad1c8eab, 0x5ee43b66), LEPT_UINT64_C2(0xda324365, 0x0005eecf),
+    LEPT_UINT64_C2(0xd863b256, 0x369d4a40), LEPT_UINT64_C2(0x90bed43e, 0x40076a82),
+    LEPT_UINT64_C2(0x873e4f75, 0xe2224e68), LEPT_UINT64_C2(0x5a7744a6, 0xe804a291),
+    LEPT_UINT64_C2(0xa90de353, 0x5aaae202), LEPT_UINT64_C2(0x711515d0, 0xa205cb36),
+    LEPT_UINT64_C2(0xd3515c28, 0x31559a83), LEPT_UINT64_C2(0x0d5a5b44, 0xca873e03),
+    LEPT_UINT64_C2(0x8412d999, 0x1ed58091), LEPT_UINT64_C2(0xe858790a, 0xfe9486c2),
+    LEPT_UINT64_C2(0xa5178fff, 0x668ae0b6), LEPT_UINT64_C2(0x626e974d, 0xbe39a872),
+    LEPT_UINT64_C2(0xce5d73ff, 0x402d98e3), LEPT_UINT64_C2(0xfb0a3d21, 0x2dc8128f),
+    LEPT_UINT64_C2(0x80fa687f, 0x881c7f8e), LEPT_UINT64_C2(0x7ce66634, 0xbc9d0b99),
+    LEPT_UINT64_C2(0xa139029f, 0x6a239f72), LEPT_UINT64_C2(0x1c1fffc1, 0xebc44e80),
+    LEPT_UINT64_C2(0xc9874347, 0x44ac874e), LEPT_UINT64_C2(0xa327ffb2, 0x66b56220),
+    LEPT_UINT64_C2(0xfbe91419, 0x15d7a922), LEPT_UINT64_C2(0x4bf1ff9f, 0x0062baa8),
+    LEPT_UINT64_C2(0x9d71ac8f, 0xada6c9b5), LEPT_UINT64_C2(0x6f773fc3, 0x603db4a9),
+    LEPT_UINT64_C2(0xc4ce17b3, 0x99107c22), LEPT_UINT64_C2(0xcb550fb4, 0x384d21d3),
+    LEPT_UINT64_C2(0xf6019da0, 0x7f549b2b), LEPT_UINT64_C2(0x7e2a53a1, 0x46606a48),
+    LEPT_UINT64_C2(0x99c10284, 0x4f94e0fb), LEPT_UINT64_C2(0x2eda7444, 0xcbfc426d),
+    LEPT_UINT64_C2(0xc0314325, 0x637a1939), LEPT_UINT64_C2(0xfa911155, 0xfefb5308),
+    LEPT_UINT64_C2(0xf03d93ee, 0xbc589f88), LEPT_UINT64_C2(0x793555ab, 0x7eba27ca),
+    LEPT_UINT64_C2(0x96267c75, 0x35b763b5), LEPT_UINT64_C2(0x4bc1558b, 0x2f3458de),
+    LEPT_UINT64_C2(0xbbb01b92, 0x83253ca2), LEPT_UINT64_C2(0x9eb1aaed, 0xfb016f16),
+    LEPT_UINT64_C2(0xea9c2277, 0x23ee8bcb), LEPT_UINT64_C2(0x465e15a9, 0x79c1cadc),
+    LEPT_UINT64_C2(0x92a1958a, 0x7675175f), LEPT_UINT64_C2(0x0bfacd89, 0xec191ec9),
+    LEPT_UINT64_C2(0xb749faed, 0x14125d36), LEPT_UINT64_C2(0xcef980ec, 0x671f667b),
+    LEPT_UINT64_C2(0xe51c79a8, 0x5916f484), LEPT_UINT64_C2(0x82b7e127, 0x80e7401a),
+    LEPT_UINT64_C2(0x8f31cc09, 0x37ae58d2), LEPT_UINT64_C2(0xd1b2ecb8, 0xb0908810),
+    LEPT_UINT64_C2(0xb2fe3f0b, 0x8599ef07), LEPT_UINT64_C2(0x861fa7e6, 0xdcb4aa15),
+    LEPT_UINT64_C2(0xdfbdcece, 0x67006ac9), LEPT_UINT64_C2(0x67a791e0, 0x93e1d49a),
+    LEPT_UINT64_C2(0x8bd6a141, 0x006042bd), LEPT_UINT64_C2(0xe0c8bb2c, 0x5c6d24e0),
+    LEPT_UINT64_C2(0xaecc4991, 0x4078536d), LEPT_UINT64_C2(0x58fae9f7, 0x73886e18),
+    LEPT_UINT64_C2(0xda7f5bf5, 0x90966848), LEPT_UINT64_C2(0xaf39a475, 0x506a899e),
+    LEPT_UINT64_C2(0x888f9979, 0x7a5e012d), LEPT_UINT64_C2(0x6d8406c9, 0x52429603),
+    LEPT_UINT64_C2(0xaab37fd7, 0xd8f58178), LEPT_UINT64_C2(0xc8e5087b, 0xa6d33b83),
+    LEPT_UINT64_C2(0xd5605fcd, 0xcf32e1d6), LEPT_UINT64_C2(0xfb1e4a9a, 0x90880a64),
+    LEPT_UINT64_C2(0x855c3be0, 0xa17fcd26), LEPT_UINT64_C2(0x5cf2eea0, 0x9a55067f),
+    LEPT_UINT64_C2(0xa6b34ad8, 0xc9dfc06f), LEPT_UINT64_C2(0xf42faa48, 0xc0ea481e),
+    LEPT_UINT64_C2(0xd0601d8e, 0xfc57b08b), LEPT_UINT64_C2(0xf13b94da, 0xf124da26),
+    LEPT_UINT64_C2(0x823c1279, 0x5db6ce57), LEPT_UINT64_C2(0x76c53d08, 0xd6b70858),
+    LEPT_UINT64_C2(0xa2cb1717, 0xb52481ed), LEPT_UINT64_C2(0x54768c4b, 0x0c64ca6e),
+    LEPT_UINT64_C2(0xcb7ddcdd, 0xa26da268), LEPT_UINT64_C2(0xa9942f5d, 0xcf7dfd09),
+    LEPT_UINT64_C2(0xfe5d5415, 0x0b090b02), LEPT_UINT64_C2(0xd3f93b35, 0x435d7c4c),
+    LEPT_UINT64_C2(0x9efa548d, 0x26e5a6e1), LEPT_UINT64_C2(0xc47bc501, 0x4a1a6daf),
+    LEPT_UINT64_C2(0xc6b8e9b0, 0x709f109a), LEPT_UINT64_C2(0x359ab641, 0x9ca1091b),
+    LEPT_UINT64_C2(0xf867241c, 0x8cc6d4c0), LEPT_UINT64_C2(0xc30163d2, 0x03c94b62),
+    LEPT_UINT64_C2(0x9b407691, 0xd7fc44f8), LEPT_UINT64_C2(0x79e0de63, 0x425dcf1d),
+    LEPT_UINT64_C2(0xc2109436, 0x4dfb5636), LEPT_UINT64_C2(0x985915fc, 0x12f542e4),
+    LEPT_UINT64_C2(0xf294b943, 0xe17a2bc4), LEPT_UINT64_C2(0x3e6f5b7b, 0x17b2939d),
+    LEPT_UINT64_C2(0x979cf3ca, 0x6cec5b5a), LEPT_UINT64_C2(0xa705992c, 0xeecf9c42),
+    LEPT_UINT64_C2(0xbd8430bd, 0x08277231), LEPT_UINT64_C2(0x50c6ff78, 0x2a838353),
+    LEPT_UINT64_C2(0xece53cec, 0x4a314ebd), LEPT_UINT64_C2(0xa4f8bf56, 0x35246428),
+    LEPT_UINT64_C2(0x940f4613, 0xae5ed136), LEPT_UINT64_C2(0x871b7795, 0xe136be99),
+    LEPT_UINT64_C2(0xb9131798, 0x99f68584), LEPT_UINT64_C2(0x28e2557b, 0x59846e3f),
+    LEPT_UINT64_C2(0xe757dd7e, 0xc07426e5), LEPT_UINT64_C2(0x331aeada, 0x2fe589cf),
+    LEPT_UINT64_C2(0x9096ea6f, 0x3848984f), LEPT_UINT64_C2(0x3ff0d2c8, 0x5def7621),
+    LEPT_UINT64_C2(0xb4bca50b, 0x065abe63), LEPT_UINT64_C2(0x0fed077a, 0x756b53a9),
+    LEPT_UINT64_C2(0xe1ebce4d, 0xc7f16dfb), LEPT_UINT64_C2(0xd3e84959, 0x12c62894),
+    LEPT_UINT64_C2(0x8d3360f0, 0x9cf6e4bd), LEPT_UINT64_C2(0x64712dd7, 0xabbbd95c),
+    LEPT_UINT64_C2(0xb080392c, 0xc4349dec), LEPT_UINT64_C2(0xbd8d794d, 0x96aacfb3),
+    LEPT_UINT64_C2(0xdca04777, 0xf541c567), LEPT_UINT64_C2(0xecf0d7a0, 0xfc5583a0),
+    LEPT_UINT64_C2(0x89e42caa, 0xf9491b60), LEPT_UINT64_C2(0xf41686c4, 0x9db57244),
+    LEPT_UINT64_C2(0xac5d37d5, 0xb79b6239), LEPT_UINT64_C2(0x311c2875, 0xc522ced5),
+    LEPT_UINT64_C2(0xd77485cb, 0x25823ac7), LEPT_UINT64_C2(0x7d633293, 0x366b828b),
+    LEPT_UINT64_C2(0x86a8d39e, 0xf77164bc), LEPT_UINT64_C2(0xae5dff9c, 0x02033197),
+    LEPT_UINT64_C2(0xa8530886, 0xb54dbdeb), LEPT_UINT64_C2(0xd9f57f83, 0x0283fdfc),
+    LEPT_UINT64_C2(0xd267caa8, 0x62a12d66), LEPT_UINT64_C2(0xd072df63, 0xc324fd7b),
+    LEPT_UINT64_C2(0x8380dea9, 0x3da4bc60), LEPT_UINT64_C2(0x4247cb9e, 0x59f71e6d),
+    LEPT_UINT64_C2(0xa4611653, 0x8d0deb78), LEPT_UINT64_C2(0x52d9be85, 0xf074e608),
+    LEPT_UINT64_C2(0xcd795be8, 0x70516656), LEPT_UINT64_C2(0x67902e27, 0x6c921f8b),
+    LEPT_UINT64_C2(0x806bd971, 0x4632dff6), LEPT_UINT64_C2(0x00ba1cd8, 0xa3db53b6),
+    LEPT_UINT64_C2(0xa086cfcd, 0x97bf97f3), LEPT_UINT64_C2(0x80e8a40e, 0xccd228a4),
+    LEPT_UINT64_C2(0xc8a883c0, 0xfdaf7df0), LEPT_UINT64_C2(0x6122cd12, 0x8006b2cd),
+    LEPT_UINT64_C2(0xfad2a4b1, 0x3d1b5d6c), LEPT_UINT64_C2(0x796b8057, 0x20085f81),
+    LEPT_UINT64_C2(0x9cc3a6ee, 0xc6311a63), LEPT_UINT64_C2(0xcbe33036, 0x74053bb0),
+    LEPT_UINT64_C2(0xc3f490aa, 0x77bd60fc), LEPT_UINT64_C2(0xbedbfc44, 0x11068a9c),
+    LEPT_UINT64_C2(0xf4f1b4d5, 0x15acb93b), LEPT_UINT64_C2(0xee92fb55, 0x15482d44),
+    LEPT_UINT64_C2(0x99171105, 0x2d8bf3c5), LEPT_UINT64_C2(0x751bdd15, 0x2d4d1c4a),
+    LEPT_UINT64_C2(0xbf5cd546, 0x78eef0b6), LEPT_UINT64_C2(0xd262d45a, 0x78a0635d),
+    LEPT_UINT64_C2(0xef340a98, 0x172aace4), LEPT_UINT64_C2(0x86fb8971, 0x16c87c34),
+    LEPT_UINT64_C2(0x9580869f, 0x0e7aac0e), LEPT_UINT64_C2(0xd45d35e6, 0xae3d4da0),
+    LEPT_UINT64_C2(0xbae0a846, 0xd2195712), LEPT_UINT64_C2(0x89748360, 0x59cca109),
+    LEPT_UINT64_C2(0xe998d258, 0x869facd7), LEPT_UINT64_C2(0x2bd1a438, 0x703fc94b),
+    LEPT_UINT64_C2(0x91ff8377, 0x5423cc06), LEPT_UINT64_C2(0x7b6306a3, 0x4627ddcf),
+    LEPT_UINT64_C2(0xb67f6455, 0x292cbf08), LEPT_UINT64_C2(0x1a3bc84c, 0x17b1d542),
+    LEPT_UINT64_C2(0xe41f3d6a, 0x7377eeca), LEPT_UINT64_C2(0x20caba5f, 0x1d9e4a93),
+    LEPT_UINT64_C2(0x8e938662, 0x882af53e), LEPT_UINT64_C2(0x547eb47b, 0x7282ee9c),
+    LEPT_UINT64_C2(0xb23867fb, 0x2a35b28d), LEPT_UINT64_C2(0xe99e619a, 0x4f23aa43),
+    LEPT_UINT64_C2(0xdec681f9, 0xf4c31f31), LEPT_UINT64_C2(0x6405fa00, 0xe2ec94d4),
+    LEPT_UINT64_C2(0x8b3c113c, 0x38f9f37e), LEPT_UINT64_C2(0xde83bc40, 0x8dd3dd04),
+    LEPT_UINT64_C2(0xae0b158b, 0x4738705e), LEPT_UINT64_C2(0x9624ab50, 0xb148d445),
+    LEPT_UINT64_C2(0xd98ddaee, 0x19068c76), LEPT_UINT64_C2(0x3badd624, 0xdd9b0957),
+    LEPT_UINT64_C2(0x87f8a8d4, 0xcfa417c9), LEPT_UINT64_C2(0xe54ca5d7, 0x0a80e5d6),
+    LEPT_UINT64_C2(0xa9f6d30a, 0x038d1dbc), LEPT_UINT64_C2(0x5e9fcf4c, 0xcd211f4c),
+    LEPT_UINT64_C2(0xd47487cc, 0x8470652b), LEPT_UINT64_C2(0x7647c320, 0x0069671f),
+    LEPT_UINT64_C2(0x84c8d4df, 0xd2c63f3b), LEPT_UINT64_C2(0x29ecd9f4, 0x0041e073),
+    LEPT_UINT64_C2(0xa5fb0a17, 0xc777cf09), LEPT_UINT64_C2(0xf4681071, 0x00525890),
+    LEPT_UINT64_C2(0xcf79cc9d, 0xb955c2cc), LEPT_UINT64_C2(0x7182148d, 0x4066eeb4),
+    LEPT_UINT64_C2(0x81ac1fe2, 0x93d599bf), LEPT_UINT64_C2(0xc6f14cd8, 0x48405530),
+    LEPT_UINT64_C2(0xa21727db, 0x38cb002f), LEPT_UINT64_C2(0xb8ada00e, 0x5a506a7c),
+    LEPT_UINT64_C2(0xca9cf1d2, 0x06fdc03b), LEPT_UINT64_C2(0xa6d90811, 0xf0e4851c),
+    LEPT_UINT64_C2(0xfd442e46, 0x88bd304a), LEPT_UINT64_C2(0x908f4a16, 0x6d1da663),
+    LEPT_UINT64_C2(0x9e4a9cec, 0x15763e2e), LEPT_UINT64_C2(0x9a598e4e, 0x043287fe),
+    LEPT_UINT64_C2(0xc5dd4427, 0x1ad3cdba), LEPT_UINT64_C2(0x40eff1e1, 0x853f29fd),
+    LEPT_UINT64_C2(0xf7549530, 0xe188c128), LEPT_UINT64_C2(0xd12bee59, 0xe68ef47c),
+    LEPT_UINT64_C2(0x9a94dd3e, 0x8cf578b9), LEPT_UINT64_C2(0x82bb74f8, 0x301958ce),
+    LEPT_UINT64_C2(0xc13a148e, 0x3032d6e7), LEPT_UINT64_C2(0xe36a5236, 0x3c1faf01),
+    LEPT_UINT64_C2(0xf18899b1, 0xbc3f8ca1), LEPT_UINT64_C2(0xdc44e6c3, 0xcb279ac1),
+    LEPT_UINT64_C2(0x96f5600f, 0x15a7b7e5), LEPT_UINT64_C2(0x29ab103a, 0x5ef8c0b9),
+    LEPT_UINT64_C2(0xbcb2b812, 0xdb11a5de), LEPT_UINT64_C2(0x7415d448, 0xf6b6f0e7),
+    LEPT_UINT64_C2(0xebdf6617, 0x91d60f56), LEPT_UINT64_C2(0x111b495b, 0x3464ad21),
+    LEPT_UINT64_C2(0x936b9fce, 0xbb25c995), LEPT_UINT64_C2(0xcab10dd9, 0x00beec34),
+    LEPT_UINT64_C2(0xb84687c2, 0x69ef3bfb), LEPT_UINT64_C2(0x3d5d514f, 0x40eea742),
+    LEPT_UINT64_C2(0xe65829b3, 0x046b0afa), LEPT_UINT64_C2(0x0cb4a5a3, 0x112a5112),
+    LEPT_UINT64_C2(0x8ff71a0f, 0xe2c2e6dc), LEPT_UINT64_C2(0x47f0e785, 0xeaba72ab),
+    LEPT_UINT64_C2(0xb3f4e093, 0xdb73a093), LEPT_UINT64_C2(0x59ed2167, 0x65690f56),
+    LEPT_UINT64_C2(0xe0f218b8, 0xd25088b8), LEPT_UINT64_C2(0x306869c1, 0x3ec3532c),
+    LEPT_UINT64_C2(0x8c974f73, 0x83725573), LEPT_UINT64_C2(0x1e414218, 0xc73a13fb),
+    LEPT_UINT64_C2(0xafbd2350, 0x644eeacf), LEPT_UINT64_C2(0xe5d1929e, 0xf90898fa),
+    LEPT_UINT64_C2(0xdbac6c24, 0x7d62a583), LEPT_UINT64_C2(0xdf45f746, 0xb74abf39),
+    LEPT_UINT64_C2(0x894bc396, 0xce5da772), LEPT_UINT64_C2(0x6b8bba8c, 0x328eb783),
+    LEPT_UINT64_C2(0xab9eb47c, 0x81f5114f), LEPT_UINT64_C2(0x066ea92f, 0x3f326564),
+    LEPT_UINT64_C2(0xd686619b, 0xa27255a2), LEPT_UINT64_C2(0xc80a537b, 0x0efefebd),
+    LEPT_UINT64_C2(0x8613fd01, 0x45877585), LEPT_UINT64_C2(0xbd06742c, 0xe95f5f36),
+    LEPT_UINT64_C2(0xa798fc41, 0x96e952e7), LEPT_UINT64_C2(0x2c481138, 0x23b73704),
+    LEPT_UINT64_C2(0xd17f3b51, 0xfca3a7a0), LEPT_UINT64_C2(0xf75a1586, 0x2ca504c5),
+    LEPT_UINT64_C2(0x82ef8513, 0x3de648c4), LEPT_UINT64_C2(0x9a984d73, 0xdbe722fb),
+    LEPT_UINT64_C2(0xa3ab6658, 0x0d5fdaf5), LEPT_UINT64_C2(0xc13e60d0, 0xd2e0ebba),
+    LEPT_UINT64_C2(0xcc963fee, 0x10b7d1b3), LEPT_UINT64_C2(0x318df905, 0x079926a8),
+    LEPT_UINT64_C2(0xffbbcfe9, 0x94e5c61f), LEPT_UINT64_C2(0xfdf17746, 0x497f7052),
+    LEPT_UINT64_C2(0x9fd561f1, 0xfd0f9bd3), LEPT_UINT64_C2(0xfeb6ea8b, 0xedefa633),
+    LEPT_UINT64_C2(0xc7caba6e, 0x7c5382c8), LEPT_UINT64_C2(0xfe64a52e, 0xe96b8fc0),
+    LEPT_UINT64_C2(0xf9bd690a, 0x1b68637b), LEPT_UINT64_C2(0x3dfdce7a, 0xa3c673b0),
+    LEPT_UINT64_C2(0x9c1661a6, 0x51213e2d), LEPT_UINT64_C2(0x06bea10c, 0xa65c084e),
+    LEPT_UINT64_C2(0xc31bfa0f, 0xe5698db8), LEPT_UINT64_C2(0x486e494f, 0xcff30a62),
+    LEPT_UINT64_C2(0xf3e2f893, 0xdec3f126), LEPT_UINT64_C2(0x5a89dba3, 0xc3efccfa),
+    LEPT_UINT64_C2(0x986ddb5c, 0x6b3a76b7), LEPT_UINT64_C2(0xf8962946, 0x5a75e01c),
+    LEPT_UINT64_C2(0xbe895233, 0x86091465), LEPT_UINT64_C2(0xf6bbb397, 0xf1135823),
+    LEPT_UINT64_C2(0xee2ba6c0, 0x678b597f), LEPT_UINT64_C2(0x746aa07d, 0xed582e2c),
+    LEPT_UINT64_C2(0x94db4838, 0x40b717ef), LEPT_UINT64_C2(0xa8c2a44e, 0xb4571cdc),
+    LEPT_UINT64_C2(0xba121a46, 0x50e4ddeb), LEPT_UINT64_C2(0x92f34d62, 0x616ce413),
+    LEPT_UINT64_C2(0xe896a0d7, 0xe51e1566), LEPT_UINT64_C2(0x77b020ba, 0xf9c81d17),
+    LEPT_UINT64_C2(0x915e2486, 0xef32cd60), LEPT_UINT64_C2(0x0ace1474, 0xdc1d122e),
+    LEPT_UINT64_C2(0xb5b5ada8, 0xaaff80b8), LEPT_UINT64_C2(0x0d819992, 0x132456ba),
+    LEPT_UINT64_C2(0xe3231912, 0xd5bf60e6), LEPT_UINT64_C2(0x10e1fff6, 0x97ed6c69),
+    LEPT_UINT64_C2(0x8df5efab, 0xc5979c8f), LEPT_UINT64_C2(0xca8d3ffa, 0x1ef463c1),
+    LEPT_UINT64_C2(0xb1736b96, 0xb6fd83b3), LEPT_UINT64_C2(0xbd308ff8, 0xa6b17cb2),
+    LEPT_UINT64_C2(0xddd0467c, 0x64bce4a0), LEPT_UINT64_C2(0xac7cb3f6, 0xd05ddbde),
+    LEPT_UINT64_C2(0x8aa22c0d, 0xbef60ee4), LEPT_UINT64_C2(0x6bcdf07a, 0x423aa96b),
+    LEPT_UINT64_C2(0xad4ab711, 0x2eb3929d), LEPT_UINT64_C2(0x86c16c98, 0xd2c953c6),
+    LEPT_UINT64_C2(0xd89d64d5, 0x7a607744), LEPT_UINT64_C2(0xe871c7bf, 0x077ba8b7),
+    LEPT_UINT64_C2(0x87625f05, 0x6c7c4a8b), LEPT_UINT64_C2(0x11471cd7, 0x64ad4972),
+    LEPT_UINT64_C2(0xa93af6c6, 0xc79b5d2d), LEPT_UINT64_C2(0xd598e40d, 0x3dd89bcf),
+    LEPT_UINT64_C2(0xd389b478, 0x79823479), LEPT_UINT64_C2(0x4aff1d10, 0x8d4ec2c3),
+    LEPT_UINT64_C2(0x843610cb, 0x4bf160cb), LEPT_UINT64_C2(0xcedf722a, 0x585139ba),
+    LEPT_UINT64_C2(0xa54394fe, 0x1eedb8fe), LEPT_UINT64_C2(0xc2974eb4, 0xee658828),
+    LEPT_UINT64_C2(0xce947a3d, 0xa6a9273e), LEPT_UINT64_C2(0x733d2262, 0x29feea32),
+    LEPT_UINT64_C2(0x811ccc66, 0x8829b887), LEPT_UINT64_C2(0x0806357d, 0x5a3f525f),
+    LEPT_UINT64_C2(0xa163ff80, 0x2a3426a8), LEPT_UINT64_C2(0xca07c2dc, 0xb0cf26f7),
+    LEPT_UINT64_C2(0xc9bcff60, 0x34c13052), LEPT_UINT64_C2(0xfc89b393, 0xdd02f0b5),
+    LEPT_UINT64_C2(0xfc2c3f38, 0x41f17c67), LEPT_UINT64_C2(0xbbac2078, 0xd443ace2),
+    LEPT_UINT64_C2(0x9d9ba783, 0x2936edc0), LEPT_UINT64_C2(0xd54b944b, 0x84aa4c0d),
+    LEPT_UINT64_C2(0xc5029163, 0xf384a931), LEPT_UINT64_C2(0x0a9e795e, 0x65d4df11),
+    LEPT_UINT64_C2(0xf64335bc, 0xf065d37d), LEPT_UINT64_C2(0x4d4617b5, 0xff4a16d5),
+    LEPT_UINT64_C2(0x99ea0196, 0x163fa42e), LEPT_UINT64_C2(0x504bced1, 0xbf8e4e45),
+    LEPT_UINT64_C2(0xc06481fb, 0x9bcf8d39), LEPT_UINT64_C2(0xe45ec286, 0x2f71e1d6),
+    LEPT_UINT64_C2(0xf07da27a, 0x82c37088), LEPT_UINT64_C2(0x5d767327, 0xbb4e5a4c),
+    LEPT_UINT64_C2(0x964e858c, 0x91ba2655), LEPT_UINT64_C2(0x3a6a07f8, 0xd510f86f),
+    LEPT_UINT64_C2(0xbbe226ef, 0xb628afea), LEPT_UINT64_C2(0x890489f7, 0x0a55368b),
+    LEPT_UINT64_C2(0xeadab0ab, 0xa3b2dbe5), LEPT_UINT64_C2(0x2b45ac74, 0xccea842e),
+    LEPT_UINT64_C2(0x92c8ae6b, 0x464fc96f), LEPT_UINT64_C2(0x3b0b8bc9, 0x0012929d),
+    LEPT_UINT64_C2(0xb77ada06, 0x17e3bbcb), LEPT_UINT64_C2(0x09ce6ebb, 0x40173744),
+    LEPT_UINT64_C2(0xe5599087, 0x9ddcaabd), LEPT_UINT64_C2(0xcc420a6a, 0x101d0515),
+    LEPT_UINT64_C2(0x8f57fa54, 0xc2a9eab6), LEPT_UINT64_C2(0x9fa94682, 0x4a12232d),
+    LEPT_UINT64_C2(0xb32df8e9, 0xf3546564), LEPT_UINT64_C2(0x47939822, 0xdc96abf9),
+    LEPT_UINT64_C2(0xdff97724, 0x70297ebd), LEPT_UINT64_C2(0x59787e2b, 0x93bc56f7),
+    LEPT_UINT64_C2(0x8bfbea76, 0xc619ef36), LEPT_UINT64_C2(0x57eb4edb, 0x3c55b65a),
+    LEPT_UINT64_C2(0xaefae514, 0x77a06b03), LEPT_UINT64_C2(0xede62292, 0x0b6b23f1),
+    LEPT_UINT64_C2(0xdab99e59, 0x958885c4), LEPT_UINT64_C2(0xe95fab36, 0x8e45eced),
+    LEPT_UINT64_C2(0x88b402f7, 0xfd75539b), LEPT_UINT64_C2(0x11dbcb02, 0x18ebb414),
+    LEPT_UINT64_C2(0xaae103b5, 0xfcd2a881), LEPT_UINT64_C2(0xd652bdc2, 0x9f26a119),
+    LEPT_UINT64_C2(0xd59944a3, 0x7c0752a2), LEPT_UINT64_C2(0x4be76d33, 0x46f0495f),
+    LEPT_UINT64_C2(0x857fcae6, 0x2d8493a5), LEPT_UINT64_C2(0x6f70a440, 0x0c562ddb),
+    LEPT_UINT64_C2(0xa6dfbd9f, 0xb8e5b88e), LEPT_UINT64_C2(0xcb4ccd50, 0x0f6bb952),
+    LEPT_UINT64_C2(0xd097ad07, 0xa71f26b2), LEPT_UINT64_C2(0x7e2000a4, 0x1346a7a7),
+    LEPT_UINT64_C2(0x825ecc24, 0xc873782f), LEPT_UINT64_C2(0x8ed40066, 0x8c0c28c8),
+    LEPT_UINT64_C2(0xa2f67f2d, 0xfa90563b), LEPT_UINT64_C2(0x72890080, 0x2f0f32fa),
+    LEPT_UINT64_C2(0xcbb41ef9, 0x79346bca), LEPT_UINT64_C2(0x4f2b40a0, 0x3ad2ffb9),
+    LEPT_UINT64_C2(0xfea126b7, 0xd78186bc), LEPT_UINT64_C2(0xe2f610c8, 0x4987bfa8),
+    LEPT_UINT64_C2(0x9f24b832, 0xe6b0f436), LEPT_UINT64_C2(0x0dd9ca7d, 0x2df4d7c9),
+    LEPT_UINT64_C2(0xc6ede63f, 0xa05d3143), LEPT_UINT64_C2(0x91503d1c, 0x79720dbb),
+    LEPT_UINT64_C2(0xf8a95fcf, 0x88747d94), LEPT_UINT64_C2(0x75a44c63, 0x97ce912a),
+    LEPT_UINT64_C2(0x9b69dbe1, 0xb548ce7c), LEPT_UINT64_C2(0xc986afbe, 0x3ee11aba),
+    LEPT_UINT64_C2(0xc24452da, 0x229b021b), LEPT_UINT64_C2(0xfbe85bad, 0xce996168),
+    LEPT_UINT64_C2(0xf2d56790, 0xab41c2a2), LEPT_UINT64_C2(0xfae27299, 0x423fb9c3),
+    LEPT_UINT64_C2(0x97c560ba, 0x6b0919a5), LEPT_UINT64_C2(0xdccd879f, 0xc967d41a),
+    LEPT_UINT64_C2(0xbdb6b8e9, 0x05cb600f), LEPT_UINT64_C2(0x5400e987, 0xbbc1c920),
+    LEPT_UINT64_C2(0xed246723, 0x473e3813), LEPT_UINT64_C2(0x290123e9, 0xaab23b68),
+    LEPT_UINT64_C2(0x9436c076, 0x0c86e30b), LEPT_UINT64_C2(0xf9a0b672, 0x0aaf6521),
+    LEPT_UINT64_C2(0xb9447093, 0x8fa89bce), LEPT_UINT64_C2(0xf808e40e, 0x8d5b3e69),
+    LEPT_UINT64_C2(0xe7958cb8, 0x7392c2c2), LEPT_UINT64_C2(0xb60b1d12, 0x30b20e04),
+    LEPT_UINT64_C2(0x90bd77f3, 0x483bb9b9), LEPT_UINT64_C2(0xb1c6f22b, 0x5e6f48c2),
+    LEPT_UINT64_C2(0xb4ecd5f0, 0x1a4aa828), LEPT_UINT64_C2(0x1e38aeb6, 0x360b1af3),
+    LEPT_UINT64_C2(0xe2280b6c, 0x20dd5232), LEPT_UINT64_C2(0x25c6da63, 0xc38de1b0),
+    LEPT_UINT64_C2(0x8d590723, 0x948a535f), LEPT_UINT64_C2(0x579c487e, 0x5a38ad0e),
+    LEPT_UINT64_C2(0xb0af48ec, 0x79ace837), LEPT_UINT64_C2(0x2d835a9d, 0xf0c6d851),
+    LEPT_UINT64_C2(0xdcdb1b27, 0x98182244), LEPT_UINT64_C2(0xf8e43145, 0x6cf88e65),
+    LEPT_UINT64_C2(0x8a08f0f8, 0xbf0f156b), LEPT_UINT64_C2(0x1b8e9ecb, 0x641b58ff),
+    LEPT_UINT64_C2(0xac8b2d36, 0xeed2dac5), LEPT_UINT64_C2(0xe272467e, 0x3d222f3f),
+    LEPT_UINT64_C2(0xd7adf884, 0xaa879177), LEPT_UINT64_C2(0x5b0ed81d, 0xcc6abb0f),
+    LEPT_UINT64_C2(0x86ccbb52, 0xea94baea), LEPT_UINT64_C2(0x98e94712, 0x9fc2b4e9),
+    LEPT_UINT64_C2(0xa87fea27, 0xa539e9a5), LEPT_UINT64_C2(0x3f2398d7, 0x47b36224),
+    LEPT_UINT64_C2(0xd29fe4b1, 0x8e88640e), LEPT_UINT64_C2(0x8eec7f0d, 0x19a03aad),
+    LEPT_UINT64_C2(0x83a3eeee, 0xf9153e89), LEPT_UINT64_C2(0x1953cf68, 0x300424ac),
+    LEPT_UINT64_C2(0xa48ceaaa, 0xb75a8e2b), LEPT_UINT64_C2(0x5fa8c342, 0x3c052dd7),
+    LEPT_UINT64_C2(0xcdb02555, 0x653131b6), LEPT_UINT64_C2(0x3792f412, 0xcb06794d),
+    LEPT_UINT64_C2(0x808e1755, 0x5f3ebf11), LEPT_UINT64_C2(0xe2bbd88b, 0xbee40bd0),
+    LEPT_UINT64_C2(0xa0b19d2a, 0xb70e6ed6), LEPT_UINT64_C2(0x5b6aceae, 0xae9d0ec4),
+    LEPT_UINT64_C2(0xc8de0475, 0x64d20a8b), LEPT_UINT64_C2(0xf245825a, 0x5a445275),
+    LEPT_UINT64_C2(0xfb158592, 0xbe068d2e), LEPT_UINT64_C2(0xeed6e2f0, 0xf0d56712),
+    LEPT_UINT64_C2(0x9ced737b, 0xb6c4183d), LEPT_UINT64_C2(0x55464dd6, 0x9685606b),
+    LEPT_UINT64_C2(0xc428d05a, 0xa4751e4c), LEPT_UINT64_C2(0xaa97e14c, 0x3c26b886),
+    LEPT_UINT64_C2(0xf5330471, 0x4d9265df), LEPT_UINT64_C2(0xd53dd99f, 0x4b3066a8),
+    LEPT_UINT64_C2(0x993fe2c6, 0xd07b7fab), LEPT_UINT64_C2(0xe546a803, 0x8efe4029),
+    LEPT_UINT64_C2(0xbf8fdb78, 0x849a5f96), LEPT_UINT64_C2(0xde985204, 0x72bdd033),
+    LEPT_UINT64_C2(0xef73d256, 0xa5c0f77c), LEPT_UINT64_C2(0x963e6685, 0x8f6d4440),
+    LEPT_UINT64_C2(0x95a86376, 0x27989aad), LEPT_UINT64_C2(0xdde70013, 0x79a44aa8),
+    LEPT_UINT64_C2(0xbb127c53, 0xb17ec159), LEPT_UINT64_C2(0x5560c018, 0x580d5d52),
+    LEPT_UINT64_C2(0xe9d71b68, 0x9dde71af), LEPT_UINT64_C2(0xaab8f01e, 0x6e10b4a6),
+    LEPT_UINT64_C2(0x92267121, 0x62ab070d), LEPT_UINT64_C2(0xcab39613, 0x04ca70e8),
+    LEPT_UINT64_C2(0xb6b00d69, 0xbb55c8d1), LEPT_UINT64_C2(0x3d607b97, 0xc5fd0d22),
+    LEPT_UINT64_C2(0xe45c10c4, 0x2a2b3b05), LEPT_UINT64_C2(0x8cb89a7d, 0xb77c506a),
+    LEPT_UINT64_C2(0x8eb98a7a, 0x9a5b04e3), LEPT_UINT64_C2(0x77f3608e, 0x92adb242),
+    LEPT_UINT64_C2(0xb267ed19, 0x40f1c61c), LEPT_UINT64_C2(0x55f038b2, 0x37591ed3),
+    LEPT_UINT64_C2(0xdf01e85f, 0x912e37a3), LEPT_UINT64_C2(0x6b6c46de, 0xc52f6688),
+    LEPT_UINT64_C2(0x8b61313b, 0xbabce2c6), LEPT_UINT64_C2(0x2323ac4b, 0x3b3da015),
+    LEPT_UINT64_C2(0xae397d8a, 0xa96c1b77), LEPT_UINT64_C2(0xabec975e, 0x0a0d081a),
+    LEPT_UINT64_C2(0xd9c7dced, 0x53c72255), LEPT_UINT64_C2(0x96e7bd35, 0x8c904a21),
+    LEPT_UINT64_C2(0x881cea14, 0x545c7575), LEPT_UINT64_C2(0x7e50d641, 0x77da2e54),
+    LEPT_UINT64_C2(0xaa242499, 0x697392d2), LEPT_UINT64_C2(0xdde50bd1, 0xd5d0b9e9),
+    LEPT_UINT64_C2(0xd4ad2dbf, 0xc3d07787), LEPT_UINT64_C2(0x955e4ec6, 0x4b44e864),
+    LEPT_UINT64_C2(0x84ec3c97, 0xda624ab4), LEPT_UINT64_C2(0xbd5af13b, 0xef0b113e),
+    LEPT_UINT64_C2(0xa6274bbd, 0xd0fadd61), LEPT_UINT64_C2(0xecb1ad8a, 0xeacdd58e),
+    LEPT_UINT64_C2(0xcfb11ead, 0x453994ba), LEPT_UINT64_C2(0x67de18ed, 0xa5814af2),
+    LEPT_UINT64_C2(0x81ceb32c, 0x4b43fcf4), LEPT_UINT64_C2(0x80eacf94, 0x8770ced7),
+    LEPT_UINT64_C2(0xa2425ff7, 0x5e14fc31), LEPT_UINT64_C2(0xa1258379, 0xa94d028d),
+    LEPT_UINT64_C2(0xcad2f7f5, 0x359a3b3e), LEPT_UINT64_C2(0x096ee458, 0x13a04330),
+    LEPT_UINT64_C2(0xfd87b5f2, 0x8300ca0d), LEPT_UINT64_C2(0x8bca9d6e, 0x188853fc),
+    LEPT_UINT64_C2(0x9e74d1b7, 0x91e07e48), LEPT_UINT64_C2(0x775ea264, 0xcf55347e),
+    LEPT_UINT64_C2(0xc6120625, 0x76589dda), LEPT_UINT64_C2(0x95364afe, 0x032a819e),
+    LEPT_UINT64_C2(0xf79687ae, 0xd3eec551), LEPT_UINT64_C2(0x3a83ddbd, 0x83f52205),
+    LEPT_UINT64_C2(0x9abe14cd, 0x44753b52), LEPT_UINT64_C2(0xc4926a96, 0x72793543),
+    LEPT_UINT64_C2(0xc16d9a00, 0x95928a27), LEPT_UINT64_C2(0x75b7053c, 0x0f178294),
+    LEPT_UINT64_C2(0xf1c90080, 0xbaf72cb1), LEPT_UINT64_C2(0x5324c68b, 0x12dd6339),
+    LEPT_UINT64_C2(0x971da050, 0x74da7bee), LEPT_UINT64_C2(0xd3f6fc16, 0xebca5e04),
+    LEPT_UINT64_C2(0xbce50864, 0x92111aea), LEPT_UINT64_C2(0x88f4bb1c, 0xa6bcf585),
+    LEPT_UINT64_C2(0xec1e4a7d, 0xb69561a5), LEPT_UINT64_C2(0x2b31e9e3, 0xd06c32e6),
+    LEPT_UINT64_C2(0x9392ee8e, 0x921d5d07), LEPT_UINT64_C2(0x3aff322e, 0x62439fd0),
+    LEPT_UINT64_C2(0xb877aa32, 0x36a4b449), LEPT_UINT64_C2(0x09befeb9, 0xfad487c3),
+    LEPT_UINT64_C2(0xe69594be, 0xc44de15b), LEPT_UINT64_C2(0x4c2ebe68, 0x7989a9b4),
+    LEPT_UINT64_C2(0x901d7cf7, 0x3ab0acd9), LEPT_UINT64_C2(0x0f9d3701, 0x4bf60a11),
+    LEPT_UINT64_C2(0xb424dc35, 0x095cd80f), LEPT_UINT64_C2(0x538484c1, 0x9ef38c95),
+    LEPT_UINT64_C2(0xe12e1342, 0x4bb40e13), LEPT_UINT64_C2(0x2865a5f2, 0x06b06fba),
+    LEPT_UINT64_C2(0x8cbccc09, 0x6f5088cb), LEPT_UINT64_C2(0xf93f87b7, 0x442e45d4),
+    LEPT_UINT64_C2(0xafebff0b, 0xcb24aafe), LEPT_UINT64_C2(0xf78f69a5, 0x1539d749),
+    LEPT_UINT64_C2(0xdbe6fece, 0xbdedd5be), LEPT_UINT64_C2(0xb573440e, 0x5a884d1c),
+    LEPT_UINT64_C2(0x89705f41, 0x36b4a597), LEPT_UINT64_C2(0x31680a88, 0xf8953031),
+    LEPT_UINT64_C2(0xabcc7711, 0x8461cefc), LEPT_UINT64_C2(0xfdc20d2b, 0x36ba7c3e),
+    LEPT_UINT64_C2(0xd6bf94d5, 0xe57a42bc), LEPT_UINT64_C2(0x3d329076, 0x04691b4d),
+    LEPT_UINT64_C2(0x8637bd05, 0xaf6c69b5), LEPT_UINT64_C2(0xa63f9a49, 0xc2c1b110),
+    LEPT_UINT64_C2(0xa7c5ac47, 0x1b478423), LEPT_UINT64_C2(0x0fcf80dc, 0x33721d54),
+    LEPT_UINT64_C2(0xd1b71758, 0xe219652b), LEPT_UINT64_C2(0xd3c36113, 0x404ea4a9),
+    LEPT_UINT64_C2(0x83126e97, 0x8d4fdf3b), LEPT_UINT64_C2(0x645a1cac, 0x083126ea),
+    LEPT_UINT64_C2(0xa3d70a3d, 0x70a3d70a), LEPT_UINT64_C2(0x3d70a3d7, 0x0a3d70a4),
+    LEPT_UINT64_C2(0xcccccccc, 0xcccccccc), LEPT_UINT64_C2(0xcccccccc, 0xcccccccd),
+    LEPT_UINT64_C2(0x80000000, 0x00000000), LEPT_UINT64_C2(0x00000000, 0x00000000),
+    LEPT_UINT64_C2(0xa0000000, 0x00000000), LEPT_UINT64_C2(0x00000000, 0x00000000),
+    LEPT_UINT64_C2(0xc8000000, 0x00000000), LEPT_UINT64_C2(0x00000000, 0x00000000),
+    LEPT_UINT64_C2(0xfa000000, 0x00000000), LEPT_UINT64_C2(0x00000000, 0x00000000),
+    LEPT_UINT64_C2(0x9c400000, 0x00000000), LEPT_UINT64_C2(0x00000000, 0x00000000),
+    LEPT_UINT64_C2(0xc3500000, 0x00000000), LEPT_UINT64_C2(0x00000000, 0x00000000),
+    LEPT_UINT64_C2(0xf4240000, 0x00000000), LEPT_UINT64_C2(0x00000000, 0x00000000),
+    LEPT_UINT64_C2(0x98968000, 0x00000000), LEPT_UINT64_C2(0x00000000, 0x00000000),
+    LEPT_UINT64_C2(0xbebc2000, 0x00000000), LEPT_UINT64_C2(0x00000000, 0x00000000),
+    LEPT_UINT64_C2(0xee6b2800, 0x00000000), LEPT_UINT64_C2(0x00000000, 0x00000000),
+    LEPT_UINT64_C2(0x9502f900, 0x00000000), LEPT_UINT64_C2(0x00000000, 0x00000000),
+    LEPT_UINT64_C2(0xba43b740, 0x00000000), LEPT_UINT64_C2(0x00000000, 0x00000000),
+    LEPT_UINT64_C2(0xe8d4a510, 0x00000000), LEPT_UINT64_C2(0x00000000, 0x00000000),
+    LEPT_UINT64_C2(0x9184e72a, 0x00000000), LEPT_UINT64_C2(0x00000000, 0x00000000),
+    LEPT_UINT64_C2(0xb5e620f4, 0x80000000), LEPT_UINT64_C2(0x00000000, 0x00000000),
+    LEPT_UINT64_C2(0xe35fa931, 0xa0000000), LEPT_UINT64_C2(0x00000000, 0x00000000),
+    LEPT_UINT64_C2(0x8e1bc9bf, 0x04000000), LEPT_UINT64_C2(0x00000000, 0x00000000),
+    LEPT_UINT64_C2(0xb1a2bc2e, 0xc5000000), LEPT_UINT64_C2(0x00000000, 0x00000000),
+    LEPT_UINT64_C2(0xde0b6b3a, 0x76400000), LEPT_UINT64_C2(0x00000000, 0x00000000),
+    LEPT_UINT64_C2(0x8ac72304, 0x89e80000), LEPT_UINT64_C2(0x00000000, 0x00000000),
+    LEPT_UINT64_C2(0xad78ebc5, 0xac620000), LEPT_UINT64_C2(0x00000000, 0x00000000),
+    LEPT_UINT64_C2(0xd8d726b7, 0x177a8000), LEPT_UINT64_C2(0x00000000, 0x00000000),
+    LEPT_UINT64_C2(0x87867832, 0x6eac9000), LEPT_UINT64_C2(0x00000000, 0x00000000),
+    LEPT_UINT64_C2(0xa968163f, 0x0a57b400), LEPT_UINT64_C2(0x00000000, 0x00000000),
+    LEPT_UINT64_C2(0xd3c21bce, 0xcceda100), LEPT_UINT64_C2(0x00000000, 0x00000000),
+    LEPT_UINT64_C2(0x84595161, 0x401484a0), LEPT_UINT64_C2(0x00000000, 0x00000000),
+    LEPT_UINT64_C2(0xa56fa5b9, 0x9019a5c8), LEPT_UINT64_C2(0x00000000, 0x00000000),
+    LEPT_UINT64_C2(0xcecb8f27, 0xf4200f3a), LEPT_UINT64_C2(0x00000000, 0x00000000),
+    LEPT_UINT64_C2(0x813f3978, 0xf8940984), LEPT_UINT64_C2(0x40000000, 0x00000000),
+    LEPT_UINT64_C2(0xa18f07d7, 0x36b90be5), LEPT_UINT64_C2(0x50000000, 0x00000000),
+    LEPT_UINT64_C2(0xc9f2c9cd, 0x04674ede), LEPT_UINT64_C2(0xa4000000, 0x00000000),
+    LEPT_UINT64_C2(0xfc6f7c40, 0x45812296), LEPT_UINT64_C2(0x4d000000, 0x00000000),
+    LEPT_UINT64_C2(0x9dc5ada8, 0x2b70b59d), LEPT_UINT64_C2(0xf0200000, 0x00000000),
+    LEPT_UINT64_C2(0xc5371912, 0x364ce305), LEPT_UINT64_C2(0x6c280000, 0x00000000),
+    LEPT_UINT64_C2(0xf684df56, 0xc3e01bc6), LEPT_UINT64_C2(0xc7320000, 0x00000000),
+    LEPT_UINT64_C2(0x9a130b96, 0x3a6c115c), LEPT_UINT64_C2(0x3c7f4000, 0x00000000),
+    LEPT_UINT64_C2(0xc097ce7b, 0xc90715b3), LEPT_UINT64_C2(0x4b9f1000, 0x00000000),
+    LEPT_UINT64_C2(0xf0bdc21a, 0xbb48db20), LEPT_UINT64_C2(0x1e86d400, 0x00000000),
+    LEPT_UINT64_C2(0x96769950, 0xb50d88f4), LEPT_UINT64_C2(0x13144480, 0x00000000),
+    LEPT_UINT64_C2(0xbc143fa4, 0xe250eb31), LEPT_UINT64_C2(0x17d955a0, 0x00000000),
+    LEPT_UINT64_C2(0xeb194f8e, 0x1ae525fd), LEPT_UINT64_C2(0x5dcfab08, 0x00000000),
+    LEPT_UINT64_C2(0x92efd1b8, 0xd0cf37be), LEPT_UINT64_C2(0x5aa1cae5, 0x00000000),
+    LEPT_UINT64_C2(0xb7abc627, 0x050305ad), LEPT_UINT64_C2(0xf14a3d9e, 0x40000000),
+    LEPT_UINT64_C2(0xe596b7b0, 0xc643c719), LEPT_UINT64_C2(0x6d9ccd05, 0xd0000000),
+    LEPT_UINT64_C2(0x8f7e32ce, 0x7bea5c6f), LEPT_UINT64_C2(0xe4820023, 0xa2000000),
+    LEPT_UINT64_C2(0xb35dbf82, 0x1ae4f38b), LEPT_UINT64_C2(0xdda2802c, 0x8a800000),
+    LEPT_UINT64_C2(0xe0352f62, 0xa19e306e), LEPT_UINT64_C2(0xd50b2037, 0xad200000),
+    LEPT_UINT64_C2(0x8c213d9d, 0xa502de45), LEPT_UINT64_C2(0x4526f422, 0xcc340000),
+    LEPT_UINT64_C2(0xaf298d05, 0x0e4395d6), LEPT_UINT64_C2(0x9670b12b, 0x7f410000),
+    LEPT_UINT64_C2(0xdaf3f046, 0x51d47b4c), LEPT_UINT64_C2(0x3c0cdd76, 0x5f114000),
+    LEPT_UINT64_C2(0x88d8762b, 0xf324cd0f), LEPT_UINT64_C2(0xa5880a69, 0xfb6ac800),
+    LEPT_UINT64_C2(0xab0e93b6, 0xefee0053), LEPT_UINT64_C2(0x8eea0d04, 0x7a457a00),
+    LEPT_UINT64_C2(0xd5d238a4, 0xabe98068), LEPT_UINT64_C2(0x72a49045, 0x98d6d880),
+    LEPT_UINT64_C2(0x85a36366, 0xeb71f041), LEPT_UINT64_C2(0x47a6da2b, 0x7f864750),
+    LEPT_UINT64_C2(0xa70c3c40, 0xa64e6c51), LEPT_UINT64_C2(0x999090b6, 0x5f67d924),
+    LEPT_UINT64_C2(0xd0cf4b50, 0xcfe20765), LEPT_UINT64_C2(0xfff4b4e3, 0xf741cf6d),
+    LEPT_UINT64_C2(0x82818f12, 0x81ed449f), LEPT_UINT64_C2(0xbff8f10e, 0x7a8921a4),
+    LEPT_UINT64_C2(0xa321f2d7, 0x226895c7), LEPT_UINT64_C2(0xaff72d52, 0x192b6a0d),
+    LEPT_UINT64_C2(0xcbea6f8c, 0xeb02bb39), LEPT_UINT64_C2(0x9bf4f8a6, 0x9f764490),
+    LEPT_UINT64_C2(0xfee50b70, 0x25c36a08), LEPT_UINT64_C2(0x02f236d0, 0x4753d5b4),
+    LEPT_UINT64_C2(0x9f4f2726, 0x179a2245), LEPT_UINT64_C2(0x01d76242, 0x2c946590),
+    LEPT_UINT64_C2(0xc722f0ef, 0x9d80aad6), LEPT_UINT64_C2(0x424d3ad2, 0xb7b97ef5),
+    LEPT_UINT64_C2(0xf8ebad2b, 0x84e0d58b), LEPT_UINT64_C2(0xd2e08987, 0x65a7deb2),
+    LEPT_UINT64_C2(0x9b934c3b, 0x330c8577), LEPT_UINT64_C2(0x63cc55f4, 0x9f88eb2f),
+    LEPT_UINT64_C2(0xc2781f49, 0xffcfa6d5), LEPT_UINT64_C2(0x3cbf6b71, 0xc76b25fb),
+    LEPT_UINT64_C2(0xf316271c, 0x7fc3908a), LEPT_UINT64_C2(0x8bef464e, 0x3945ef7a),
+    LEPT_UINT64_C2(0x97edd871, 0xcfda3a56), LEPT_UINT64_C2(0x97758bf0, 0xe3cbb5ac),
+    LEPT_UINT64_C2(0xbde94e8e, 0x43d0c8ec), LEPT_UINT64_C2(0x3d52eeed, 0x1cbea317),
+    LEPT_UINT64_C2(0xed63a231, 0xd4c4fb27), LEPT_UINT64_C2(0x4ca7aaa8, 0x63ee4bdd),
+    LEPT_UINT64_C2(0x945e455f, 0x24fb1cf8), LEPT_UINT64_C2(0x8fe8caa9, 0x3e74ef6a),
+    LEPT_UINT64_C2(0xb975d6b6, 0xee39e436), LEPT_UINT64_C2(0xb3e2fd53, 0x8e122b44),
+    LEPT_UINT64_C2(0xe7d34c64, 0xa9c85d44), LEPT_UINT64_C2(0x60dbbca8, 0x7196b616),
+    LEPT_UINT64_C2(0x90e40fbe, 0xea1d3a4a), LEPT_UINT64_C2(0xbc8955e9, 0x46fe31cd),
+    LEPT_UINT64_C2(0xb51d13ae, 0xa4a488dd), LEPT_UINT64_C2(0x6babab63, 0x98bdbe41),
+    LEPT_UINT64_C2(0xe264589a, 0x4dcdab14), LEPT_UINT64_C2(0xc696963c, 0x7eed2dd1),
+    LEPT_UINT64_C2(0x8d7eb760, 0x70a08aec), LEPT_UINT64_C2(0xfc1e1de5, 0xcf543ca2),
+    LEPT_UINT64_C2(0xb0de6538, 0x8cc8ada8), LEPT_UINT64_C2(0x3b25a55f, 0x43294bcb),
+    LEPT_UINT64_C2(0xdd15fe86, 0xaffad912), LEPT_UINT64_C2(0x49ef0eb7, 0x13f39ebe),
+    LEPT_UINT64_C2(0x8a2dbf14, 0x2dfcc7ab), LEPT_UINT64_C2(0x6e356932, 0x6c784337),
+    LEPT_UINT64_C2(0xacb92ed9, 0x397bf996), LEPT_UINT64_C2(0x49c2c37f, 0x07965404),
+    LEPT_UINT64_C2(0xd7e77a8f, 0x87daf7fb), LEPT_UINT64_C2(0xdc33745e, 0xc97be906),
+    LEPT_UINT64_C2(0x86f0ac99, 0xb4e8dafd), LEPT_UINT64_C2(0x69a028bb, 0x3ded71a3),
+    LEPT_UINT64_C2(0xa8acd7c0, 0x222311bc), LEPT_UINT64_C2(0xc40832ea, 0x0d68ce0c),
+    LEPT_UINT64_C2(0xd2d80db0, 0x2aabd62b), LEPT_UINT64_C2(0xf50a3fa4, 0x90c30190),
+    LEPT_UINT64_C2(0x83c7088e, 0x1aab65db), LEPT_UINT64_C2(0x792667c6, 0xda79e0fa),
+    LEPT_UINT64_C2(0xa4b8cab1, 0xa1563f52), LEPT_UINT64_C2(0x577001b8, 0x91185938),
+    LEPT_UINT64_C2(0xcde6fd5e, 0x09abcf26), LEPT_UINT64_C2(0xed4c0226, 0xb55e6f86),
+    LEPT_UINT64_C2(0x80b05e5a, 0xc60b6178), LEPT_UINT64_C2(0x544f8158, 0x315b05b4),
+    LEPT_UINT64_C2(0xa0dc75f1, 0x778e39d6), LEPT_UINT64_C2(0x696361ae, 0x3db1c721),
+    LEPT_UINT64_C2(0xc913936d, 0xd571c84c), LEPT_UINT64_C2(0x03bc3a19, 0xcd1e38e9),
+    LEPT_UINT64_C2(0xfb587849, 0x4ace3a5f), LEPT_UINT64_C2(0x04ab48a0, 0x4065c723),
+    LEPT_UINT64_C2(0x9d174b2d, 0xcec0e47b), LEPT_UINT64_C2(0x62eb0d64, 0x283f9c76),
+    LEPT_UINT64_C2(0xc45d1df9, 0x42711d9a), LEPT_UINT64_C2(0x3ba5d0bd, 0x324f8394),
+    LEPT_UINT64_C2(0xf5746577, 0x930d6500), LEPT_UINT64_C2(0xca8f44ec, 0x7ee36479),
+    LEPT_UINT64_C2(0x9968bf6a, 0xbbe85f20), LEPT_UINT64_C2(0x7e998b13, 0xcf4e1ecb),
+    LEPT_UINT64_C2(0xbfc2ef45, 0x6ae276e8), LEPT_UINT64_C2(0x9e3fedd8, 0xc321a67e),
+    LEPT_UINT64_C2(0xefb3ab16, 0xc59b14a2), LEPT_UINT64_C2(0xc5cfe94e, 0xf3ea101e),
+    LEPT_UINT64_C2(0x95d04aee, 0x3b80ece5), LEPT_UINT64_C2(0xbba1f1d1, 0x58724a12),
+    LEPT_UINT64_C2(0xbb445da9, 0xca61281f), LEPT_UINT64_C2(0x2a8a6e45, 0xae8edc97),
+    LEPT_UINT64_C2(0xea157514, 0x3cf97226), LEPT_UINT64_C2(0xf52d09d7, 0x1a3293bd),
+    LEPT_UINT64_C2(0x924d692c, 0xa61be758), LEPT_UINT64_C2(0x593c2626, 0x705f9c56),
+    LEPT_UINT64_C2(0xb6e0c377, 0xcfa2e12e), LEPT_UINT64_C2(0x6f8b2fb0, 0x0c77836c),
+    LEPT_UINT64_C2(0xe498f455, 0xc38b997a), LEPT_UINT64_C2(0x0b6dfb9c, 0x0f956447),
+    LEPT_UINT64_C2(0x8edf98b5, 0x9a373fec), LEPT_UINT64_C2(0x4724bd41, 0x89bd5eac),
+    LEPT_UINT64_C2(0xb2977ee3, 0x00c50fe7), LEPT_UINT64_C2(0x58edec91, 0xec2cb657),
+    LEPT_UINT64_C2(0xdf3d5e9b, 0xc0f653e1), LEPT_UINT64_C2(0x2f2967b6, 0x6737e3ed),
+    LEPT_UINT64_C2(0x8b865b21, 0x5899f46c), LEPT_UINT64_C2(0xbd79e0d2, 0x0082ee74),
+    LEPT_UINT64_C2(0xae67f1e9, 0xaec07187), LEPT_UINT64_C2(0xecd85906, 0x80a3aa11),
+    LEPT_UINT64_C2(0xda01ee64, 0x1a708de9), LEPT_UINT64_C2(0xe80e6f48, 0x20cc9495),
+    LEPT_UINT64_C2(0x884134fe, 0x908658b2), LEPT_UINT64_C2(0x3109058d, 0x147fdcdd),
+    LEPT_UINT64_C2(0xaa51823e, 0x34a7eede), LEPT_UINT64_C2(0xbd4b46f0, 0x599fd415),
+    LEPT_UINT64_C2(0xd4e5e2cd, 0xc1d1ea96), LEPT_UINT64_C2(0x6c9e18ac, 0x7007c91a),
+    LEPT_UINT64_C2(0x850fadc0, 0x9923329e), LEPT_UINT64_C2(0x03e2cf6b, 0xc604ddb0),
+    LEPT_UINT64_C2(0xa6539930, 0xbf6bff45), LEPT_UINT64_C2(0x84db8346, 0xb786151c),
+    LEPT_UINT64_C2(0xcfe87f7c, 0xef46ff16), LEPT_UINT64_C2(0xe6126418, 0x65679a63),
+    LEPT_UINT64_C2(0x81f14fae, 0x158c5f6e), LEPT_UINT64_C2(0x4fcb7e8f, 0x3f60c07e),
+    LEPT_UINT64_C2(0xa26da399, 0x9aef7749), LEPT_UINT64_C2(0xe3be5e33, 0x0f38f09d),
+    LEPT_UINT64_C2(0xcb090c80, 0x01ab551c), LEPT_UINT64_C2(0x5cadf5bf, 0xd3072cc5),
+    LEPT_UINT64_C2(0xfdcb4fa0, 0x02162a63), LEPT_UINT64_C2(0x73d9732f, 0xc7c8f7f6),
+    LEPT_UINT64_C2(0x9e9f11c4, 0x014dda7e), LEPT_UINT64_C2(0x2867e7fd, 0xdcdd9afa),
+    LEPT_UINT64_C2(0xc646d635, 0x01a1511d), LEPT_UINT64_C2(0xb281e1fd, 0x541501b8),
+    LEPT_UINT64_C2(0xf7d88bc2, 0x4209a565), LEPT_UINT64_C2(0x1f225a7c, 0xa91a4226),
+    LEPT_UINT64_C2(0x9ae75759, 0x6946075f), LEPT_UINT64_C2(0x3375788d, 0xe9b06958),
+    LEPT_UINT64_C2(0xc1a12d2f, 0xc3978937), LEPT_UINT64_C2(0x0052d6b1, 0x641c83ae),
+    LEPT_UINT64_C2(0xf209787b, 0xb47d6b84), LEPT_UINT64_C2(0xc0678c5d, 0xbd23a49a),
+    LEPT_UINT64_C2(0x9745eb4d, 0x50ce6332), LEPT_UINT64_C2(0xf840b7ba, 0x963646e0),
+    LEPT_UINT64_C2(0xbd176620, 0xa501fbff), LEPT_UINT64_C2(0xb650e5a9, 0x3bc3d898),
+    LEPT_UINT64_C2(0xec5d3fa8, 0xce427aff), LEPT_UINT64_C2(0xa3e51f13, 0x8ab4cebe),
+    LEPT_UINT64_C2(0x93ba47c9, 0x80e98cdf), LEPT_UINT64_C2(0xc66f336c, 0x36b10137),
+    LEPT_UINT64_C2(0xb8a8d9bb, 0xe123f017), LEPT_UINT64_C2(0xb80b0047, 0x445d4184),
+    LEPT_UINT64_C2(0xe6d3102a, 0xd96cec1d), LEPT_UINT64_C2(0xa60dc059, 0x157491e5),
+    LEPT_UINT64_C2(0x9043ea1a, 0xc7e41392), LEPT_UINT64_C2(0x87c89837, 0xad68db2f),
+    LEPT_UINT64_C2(0xb454e4a1, 0x79dd1877), LEPT_UINT64_C2(0x29babe45, 0x98c311fb),
+    LEPT_UINT64_C2(0xe16a1dc9, 0xd8545e94), LEPT_UINT64_C2(0xf4296dd6, 0xfef3d67a),
+    LEPT_UINT64_C2(0x8ce2529e, 0x2734bb1d), LEPT_UINT64_C2(0x1899e4a6, 0x5f58660c),
+    LEPT_UINT64_C2(0xb01ae745, 0xb101e9e4), LEPT_UINT64_C2(0x5ec05dcf, 0xf72e7f8f),
+    LEPT_UINT64_C2(0xdc21a117, 0x1d42645d), LEPT_UINT64_C2(0x76707543, 0xf4fa1f73),
+    LEPT_UINT64_C2(0x899504ae, 0x72497eba), LEPT_UINT64_C2(0x6a06494a, 0x791c53a8),
+    LEPT_UINT64_C2(0xabfa45da, 0x0edbde69), LEPT_UINT64_C2(0x0487db9d, 0x17636892),
+    LEPT_UINT64_C2(0xd6f8d750, 0x9292d603), LEPT_UINT64_C2(0x45a9d284, 0x5d3c42b6),
+    LEPT_UINT64_C2(0x865b8692, 0x5b9bc5c2), LEPT_UINT64_C2(0x0b8a2392, 0xba45a9b2),
+    LEPT_UINT64_C2(0xa7f26836, 0xf282b732), LEPT_UINT64_C2(0x8e6cac77, 0x68d7141e),
+    LEPT_UINT64_C2(0xd1ef0244, 0xaf2364ff), LEPT_UINT64_C2(0x3207d795, 0x430cd926),
+    LEPT_UINT64_C2(0x8335616a, 0xed761f1f), LEPT_UINT64_C2(0x7f44e6bd, 0x49e807b8),
+    LEPT_UINT64_C2(0xa402b9c5, 0xa8d3a6e7), LEPT_UINT64_C2(0x5f16206c, 0x9c6209a6),
+    LEPT_UINT64_C2(0xcd036837, 0x130890a1), LEPT_UINT64_C2(0x36dba887, 0xc37a8c0f),
+    LEPT_UINT64_C2(0x80222122, 0x6be55a64), LEPT_UINT64_C2(0xc2494954, 0xda2c9789),
+    LEPT_UINT64_C2(0xa02aa96b, 0x06deb0fd), LEPT_UINT64_C2(0xf2db9baa, 0x10b7bd6c),
+    LEPT_UINT64_C2(0xc83553c5, 0xc8965d3d), LEPT_UINT64_C2(0x6f928294, 0x94e5acc7),
+    LEPT_UINT64_C2(0xfa42a8b7, 0x3abbf48c), LEPT_UINT64_C2(0xcb772339, 0xba1f17f9),
+    LEPT_UINT64_C2(0x9c69a972, 0x84b578d7), LEPT_UINT64_C2(0xff2a7604, 0x14536efb),
+    LEPT_UINT64_C2(0xc38413cf, 0x25e2d70d), LEPT_UINT64_C2(0xfef51385, 0x19684aba),
+    LEPT_UINT64_C2(0xf46518c2, 0xef5b8cd1), LEPT_UINT64_C2(0x7eb25866, 0x5fc25d69),
+    LEPT_UINT64_C2(0x98bf2f79, 0xd5993802), LEPT_UINT64_C2(0xef2f773f, 0xfbd97a61),
+    LEPT_UINT64_C2(0xbeeefb58, 0x4aff8603), LEPT_UINT64_C2(0xaafb550f, 0xfacfd8fa),
+    LEPT_UINT64_C2(0xeeaaba2e, 0x5dbf6784), LEPT_UINT64_C2(0x95ba2a53, 0xf983cf38),
+    LEPT_UINT64_C2(0x952ab45c, 0xfa97a0b2), LEPT_UINT64_C2(0xdd945a74, 0x7bf26183),
+    LEPT_UINT64_C2(0xba756174, 0x393d88df), LEPT_UINT64_C2(0x94f97111, 0x9aeef9e4),
+    LEPT_UINT64_C2(0xe912b9d1, 0x478ceb17), LEPT_UINT64_C2(0x7a37cd56, 0x01aab85d),
+    LEPT_UINT64_C2(0x91abb422, 0xccb812ee), LEPT_UINT64_C2(0xac62e055, 0xc10ab33a),
+    LEPT_UINT64_C2(0xb616a12b, 0x7fe617aa), LEPT_UINT64_C2(0x577b986b, 0x314d6009),
+    LEPT_UINT64_C2(0xe39c4976, 0x5fdf9d94), LEPT_UINT64_C2(0xed5a7e85, 0xfda0b80b),
+    LEPT_UINT64_C2(0x8e41ade9, 0xfbebc27d), LEPT_UINT64_C2(0x14588f13, 0xbe847307),
+    LEPT_UINT64_C2(0xb1d21964, 0x7ae6b31c), LEPT_UINT64_C2(0x596eb2d8, 0xae258fc8),
+    LEPT_UINT64_C2(0xde469fbd, 0x99a05fe3), LEPT_UINT64_C2(0x6fca5f8e, 0xd9aef3bb),
+    LEPT_UINT64_C2(0x8aec23d6, 0x80043bee), LEPT_UINT64_C2(0x25de7bb9, 0x480d5854),
+    LEPT_UINT64_C2(0xada72ccc, 0x20054ae9), LEPT_UINT64_C2(0xaf561aa7, 0x9a10ae6a),
+    LEPT_UINT64_C2(0xd910f7ff, 0x28069da4), LEPT_UINT64_C2(0x1b2ba151, 0x8094da04),
+    LEPT_UINT64_C2(0x87aa9aff, 0x79042286), LEPT_UINT64_C2(0x90fb44d2, 0xf05d0842),
+    LEPT_UINT64_C2(0xa99541bf, 0x57452b28), LEPT_UINT64_C2(0x353a1607, 0xac744a53),
+    LEPT_UINT64_C2(0xd3fa922f, 0x2d1675f2), LEPT_UINT64_C2(0x42889b89, 0x97915ce8),
+    LEPT_UINT64_C2(0x847c9b5d, 0x7c2e09b7), LEPT_UINT64_C2(0x69956135, 0xfebada11),
+    LEPT_UINT64_C2(0xa59bc234, 0xdb398c25), LEPT_UINT64_C2(0x43fab983, 0x7e699095),
+    LEPT_UINT64_C2(0xcf02b2c2, 0x1207ef2e), LEPT_UINT64_C2(0x94f967e4, 0x5e03f4bb),
+    LEPT_UINT64_C2(0x8161afb9, 0x4b44f57d), LEPT_UINT64_C2(0x1d1be0ee, 0xbac278f5),
+    LEPT_UINT64_C2(0xa1ba1ba7, 0x9e1632dc), LEPT_UINT64_C2(0x6462d92a, 0x69731732),
+    LEPT_UINT64_C2(0xca28a291, 0x859bbf93), LEPT_UINT64_C2(0x7d7b8f75, 0x03cfdcfe),
+    LEPT_UINT64_C2(0xfcb2cb35, 0xe702af78), LEPT_UINT64_C2(0x5cda7352, 0x44c3d43e),
+    LEPT_UINT64_C2(0x9defbf01, 0xb061adab), LEPT_UINT64_C2(0x3a088813, 0x6afa64a7),
+    LEPT_UINT64_C2(0xc56baec2, 0x1c7a1916), LEPT_UINT64_C2(0x088aaa18, 0x45b8fdd0),
+    LEPT_UINT64_C2(0xf6c69a72, 0xa3989f5b), LEPT_UINT64_C2(0x8aad549e, 0x57273d45),
+    LEPT_UINT64_C2(0x9a3c2087, 0xa63f6399), LEPT_UINT64_C2(0x36ac54e2, 0xf678864b),
+    LEPT_UINT64_C2(0xc0cb28a9, 0x8fcf3c7f), LEPT_UINT64_C2(0x84576a1b, 0xb416a7dd),
+    LEPT_UINT64_C2(0xf0fdf2d3, 0xf3c30b9f), LEPT_UINT64_C2(0x656d44a2, 0xa11c51d5),
+    LEPT_UINT64_C2(0x969eb7c4, 0x7859e743), LEPT_UINT64_C2(0x9f644ae5, 0xa4b1b325),
+    LEPT_UINT64_C2(0xbc4665b5, 0x96706114), LEPT_UINT64_C2(0x873d5d9f, 0x0dde1fee),
+    LEPT_UINT64_C2(0xeb57ff22, 0xfc0c7959), LEPT_UINT64_C2(0xa90cb506, 0xd155a7ea),
+    LEPT_UINT64_C2(0x9316ff75, 0xdd87cbd8), LEPT_UINT64_C2(0x09a7f124, 0x42d588f2),
+    LEPT_UINT64_C2(0xb7dcbf53, 0x54e9bece), LEPT_UINT64_C2(0x0c11ed6d, 0x538aeb2f),
+    LEPT_UINT64_C2(0xe5d3ef28, 0x2a242e81), LEPT_UINT64_C2(0x8f1668c8, 0xa86da5fa),
+    LEPT_UINT64_C2(0x8fa47579, 0x1a569d10), LEPT_UINT64_C2(0xf96e017d, 0x694487bc),
+    LEPT_UINT64_C2(0xb38d92d7, 0x60ec4455), LEPT_UINT64_C2(0x37c981dc, 0xc395a9ac),
+    LEPT_UINT64_C2(0xe070f78d, 0x3927556a), LEPT_UINT64_C2(0x85bbe253, 0xf47b1417),
+    LEPT_UINT64_C2(0x8c469ab8, 0x43b89562), LEPT_UINT64_C2(0x93956d74, 0x78ccec8e),
+    LEPT_UINT64_C2(0xaf584166, 0x54a6babb), LEPT_UINT64_C2(0x387ac8d1, 0x970027b2),
+    LEPT_UINT64_C2(0xdb2e51bf, 0xe9d0696a), LEPT_UINT64_C2(0x06997b05, 0xfcc0319e),
+    LEPT_UINT64_C2(0x88fcf317, 0xf22241e2), LEPT_UINT64_C2(0x441fece3, 0xbdf81f03),
+    LEPT_UINT64_C2(0xab3c2fdd, 0xeeaad25a), LEPT_UINT64_C2(0xd527e81c, 0xad7626c3),
+    LEPT_UINT64_C2(0xd60b3bd5, 0x6a5586f1), LEPT_UINT64_C2(0x8a71e223, 0xd8d3b074),
+    LEPT_UINT64_C2(0x85c70565, 0x62757456), LEPT_UINT64_C2(0xf6872d56, 0x67844e49),
+    LEPT_UINT64_C2(0xa738c6be, 0xbb12d16c), LEPT_UINT64_C2(0xb428f8ac, 0x016561db),
+    LEPT_UINT64_C2(0xd106f86e, 0x69d785c7), LEPT_UINT64_C2(0xe13336d7, 0x01beba52),
+    LEPT_UINT64_C2(0x82a45b45, 0x0226b39c), LEPT_UINT64_C2(0xecc00246, 0x61173473),
+    LEPT_UINT64_C2(0xa34d7216, 0x42b06084), LEPT_UINT64_C2(0x27f002d7, 0xf95d0190),
+    LEPT_UINT64_C2(0xcc20ce9b, 0xd35c78a5), LEPT_UINT64_C2(0x31ec038d, 0xf7b441f4),
+    LEPT_UINT64_C2(0xff290242, 0xc83396ce), LEPT_UINT64_C2(0x7e670471, 0x75a15271),
+    LEPT_UINT64_C2(0x9f79a169, 0xbd203e41), LEPT_UINT64_C2(0x0f0062c6, 0xe984d386),
+    LEPT_UINT64_C2(0xc75809c4, 0x2c684dd1), LEPT_UINT64_C2(0x52c07b78, 0xa3e60868),
+    LEPT_UINT64_C2(0xf92e0c35, 0x37826145), LEPT_UINT64_C2(0xa7709a56, 0xccdf8a82),
+    LEPT_UINT64_C2(0x9bbcc7a1, 0x42b17ccb), LEPT_UINT64_C2(0x88a66076, 0x400bb691),
+    LEPT_UINT64_C2(0xc2abf989, 0x935ddbfe), LEPT_UINT64_C2(0x6acff893, 0xd00ea435),
+    LEPT_UINT64_C2(0xf356f7eb, 0xf83552fe), LEPT_UINT64_C2(0x0583f6b8, 0xc4124d43),
+    LEPT_UINT64_C2(0x98165af3, 0x7b2153de), LEPT_UINT64_C2(0xc3727a33, 0x7a8b704a),
+    LEPT_UINT64_C2(0xbe1bf1b0, 0x59e9a8d6), LEPT_UINT64_C2(0x744f18c0, 0x592e4c5c),
+    LEPT_UINT64_C2(0xeda2ee1c, 0x7064130c), LEPT_UINT64_C2(0x1162def0, 0x6f79df73),
+    LEPT_UINT64_C2(0x9485d4d1, 0xc63e8be7), LEPT_UINT64_C2(0x8addcb56, 0x45ac2ba8),
+    LEPT_UINT64_C2(0xb9a74a06, 0x37ce2ee1), LEPT_UINT64_C2(0x6d953e2b, 0xd7173692),
+    LEPT_UINT64_C2(0xe8111c87, 0xc5c1ba99), LEPT_UINT64_C2(0xc8fa8db6, 0xccdd0437),
+    LEPT_UINT64_C2(0x910ab1d4, 0xdb9914a0), LEPT_UINT64_C2(0x1d9c9892, 0x400a22a2),
+    LEPT_UINT64_C2(0xb54d5e4a, 0x127f59c8), LEPT_UINT64_C2(0x2503beb6, 0xd00cab4b),
+    LEPT_UINT64_C2(0xe2a0b5dc, 0x971f303a), LEPT_UINT64_C2(0x2e44ae64, 0x840fd61d),
+    LEPT_UINT64_C2(0x8da471a9, 0xde737e24), LEPT_UINT64_C2(0x5ceaecfe, 0xd289e5d2),
+    LEPT_UINT64_C2(0xb10d8e14, 0x56105dad), LEPT_UINT64_C2(0x7425a83e, 0x872c5f47),
+    LEPT_UINT64_C2(0xdd50f199, 0x6b947518), LEPT_UINT64_C2(0xd12f124e, 0x28f77719),
+    LEPT_UINT64_C2(0x8a5296ff, 0xe33cc92f), LEPT_UINT64_C2(0x82bd6b70, 0xd99aaa6f),
+    LEPT_UINT64_C2(0xace73cbf, 0xdc0bfb7b), LEPT_UINT64_C2(0x636cc64d, 0x1001550b),
+    LEPT_UINT64_C2(0xd8210bef, 0xd30efa5a), LEPT_UINT64_C2(0x3c47f7e0, 0x5401aa4e),
+    LEPT_UINT64_C2(0x8714a775, 0xe3e95c78), LEPT_UINT64_C2(0x65acfaec, 0x34810a71),
+    LEPT_UINT64_C2(0xa8d9d153, 0x5ce3b396), LEPT_UINT64_C2(0x7f1839a7, 0x41a14d0d),
+    LEPT_UINT64_C2(0xd31045a8, 0x341ca07c), LEPT_UINT64_C2(0x1ede4811, 0x1209a050),
+    LEPT_UINT64_C2(0x83ea2b89, 0x2091e44d), LEPT_UINT64_C2(0x934aed0a, 0xab460432),
+    LEPT_UINT64_C2(0xa4e4b66b, 0x68b65d60), LEPT_UINT64_C2(0xf81da84d, 0x5617853f),
+    LEPT_UINT64_C2(0xce1de406, 0x42e3f4b9), LEPT_UINT64_C2(0x36251260, 0xab9d668e),
+    LEPT_UINT64_C2(0x80d2ae83, 0xe9ce78f3), LEPT_UINT64_C2(0xc1d72b7c, 0x6b426019),
+    LEPT_UINT64_C2(0xa1075a24, 0xe4421730), LEPT_UINT64_C2(0xb24cf65b, 0x8612f81f),
+    LEPT_UINT64_C2(0xc94930ae, 0x1d529cfc), LEPT_UINT64_C2(0xdee033f2, 0x6797b627),
+    LEPT_UINT64_C2(0xfb9b7cd9, 0xa4a7443c), LEPT_UINT64_C2(0x169840ef, 0x017da3b1),
+    LEPT_UINT64_C2(0x9d412e08, 0x06e88aa5), LEPT_UINT64_C2(0x8e1f2895, 0x60ee864e),
+    LEPT_UINT64_C2(0xc491798a, 0x08a2ad4e), LEPT_UINT64_C2(0xf1a6f2ba, 0xb92a27e2),
+    LEPT_UINT64_C2(0xf5b5d7ec, 0x8acb58a2), LEPT_UINT64_C2(0xae10af69, 0x6774b1db),
+    LEPT_UINT64_C2(0x9991a6f3, 0xd6bf1765), LEPT_UINT64_C2(0xacca6da1, 0xe0a8ef29),
+    LEPT_UINT64_C2(0xbff610b0, 0xcc6edd3f), LEPT_UINT64_C2(0x17fd090a, 0x58d32af3),
+    LEPT_UINT64_C2(0xeff394dc, 0xff8a948e), LEPT_UINT64_C2(0xddfc4b4c, 0xef07f5b0),
+    LEPT_UINT64_C2(0x95f83d0a, 0x1fb69cd9), LEPT_UINT64_C2(0x4abdaf10, 0x1564f98e),
+    LEPT_UINT64_C2(0xbb764c4c, 0xa7a4440f), LEPT_UINT64_C2(0x9d6d1ad4, 0x1abe37f1),
+    LEPT_UINT64_C2(0xea53df5f, 0xd18d5513), LEPT_UINT64_C2(0x84c86189, 0x216dc5ed),
+    LEPT_UINT64_C2(0x92746b9b, 0xe2f8552c), LEPT_UINT64_C2(0x32fd3cf5, 0xb4e49bb4),
+    LEPT_UINT64_C2(0xb7118682, 0xdbb66a77), LEPT_UINT64_C2(0x3fbc8c33, 0x221dc2a1),
+    LEPT_UINT64_C2(0xe4d5e823, 0x92a40515), LEPT_UINT64_C2(0x0fabaf3f, 0xeaa5334a),
+    LEPT_UINT64_C2(0x8f05b116, 0x3ba6832d), LEPT_UINT64_C2(0x29cb4d87, 0xf2a7400e),
+    LEPT_UINT64_C2(0xb2c71d5b, 0xca9023f8), LEPT_UINT64_C2(0x743e20e9, 0xef511012),
+    LEPT_UINT64_C2(0xdf78e4b2, 0xbd342cf6), LEPT_UINT64_C2(0x914da924, 0x6b255416),
+    LEPT_UINT64_C2(0x8bab8eef, 0xb6409c1a), LEPT_UINT64_C2(0x1ad089b6, 0xc2f7548e),
+    LEPT_UINT64_C2(0xae9672ab, 0xa3d0c320), LEPT_UINT64_C2(0xa184ac24, 0x73b529b1),
+    LEPT_UINT64_C2(0xda3c0f56, 0x8cc4f3e8), LEPT_UINT64_C2(0xc9e5d72d, 0x90a2741e),
+    LEPT_UINT64_C2(0x88658996, 0x17fb1871), LEPT_UINT64_C2(0x7e2fa67c, 0x7a658892),
+    LEPT_UINT64_C2(0xaa7eebfb, 0x9df9de8d), LEPT_UINT64_C2(0xddbb901b, 0x98feeab7),
+    LEPT_UINT64_C2(0xd51ea6fa, 0x85785631), LEPT_UINT64_C2(0x552a7422, 0x7f3ea565),
+    LEPT_UINT64_C2(0x8533285c, 0x936b35de), LEPT_UINT64_C2(0xd53a8895, 0x8f87275f),
+    LEPT_UINT64_C2(0xa67ff273, 0xb8460356), LEPT_UINT64_C2(0x8a892aba, 0xf368f137),
+    LEPT_UINT64_C2(0xd01fef10, 0xa657842c), LEPT_UINT64_C2(0x2d2b7569, 0xb0432d85),
+    LEPT_UINT64_C2(0x8213f56a, 0x67f6b29b), LEPT_UINT64_C2(0x9c3b2962, 0x0e29fc73),
+    LEPT_UINT64_C2(0xa298f2c5, 0x01f45f42), LEPT_UINT64_C2(0x8349f3ba, 0x91b47b8f),
+    LEPT_UINT64_C2(0xcb3f2f76, 0x42717713), LEPT_UINT64_C2(0x241c70a9, 0x36219a73),
+    LEPT_UINT64_C2(0xfe0efb53, 0xd30dd4d7), LEPT_UINT64_C2(0xed238cd3, 0x83aa0110),
+    LEPT_UINT64_C2(0x9ec95d14, 0x63e8a506), LEPT_UINT64_C2(0xf4363804, 0x324a40aa),
+    LEPT_UINT64_C2(0xc67bb459, 0x7ce2ce48), LEPT_UINT64_C2(0xb143c605, 0x3edcd0d5),
+    LEPT_UINT64_C2(0xf81aa16f, 0xdc1b81da), LEPT_UINT64_C2(0xdd94b786, 0x8e94050a),
+    LEPT_UINT64_C2(0x9b10a4e5, 0xe9913128), LEPT_UINT64_C2(0xca7cf2b4, 0x191c8326),
+    LEPT_UINT64_C2(0xc1d4ce1f, 0x63f57d72), LEPT_UINT64_C2(0xfd1c2f61, 0x1f63a3f0),
+    LEPT_UINT64_C2(0xf24a01a7, 0x3cf2dccf), LEPT_UINT64_C2(0xbc633b39, 0x673c8cec),
+    LEPT_UINT64_C2(0x976e4108, 0x8617ca01), LEPT_UINT64_C2(0xd5be0503, 0xe085d813),
+    LEPT_UINT64_C2(0xbd49d14a, 0xa79dbc82), LEPT_UINT64_C2(0x4b2d8644, 0xd8a74e18),
+    LEPT_UINT64_C2(0xec9c459d, 0x51852ba2), LEPT_UINT64_C2(0xddf8e7d6, 0x0ed1219e),
+    LEPT_UINT64_C2(0x93e1ab82, 0x52f33b45), LEPT_UINT64_C2(0xcabb90e5, 0xc942b503),
+    LEPT_UINT64_C2(0xb8da1662, 0xe7b00a17), LEPT_UINT64_C2(0x3d6a751f, 0x3b936243),
+    LEPT_UINT64_C2(0xe7109bfb, 0xa19c0c9d), LEPT_UINT64_C2(0x0cc51267, 0x0a783ad4),
+    LEPT_UINT64_C2(0x906a617d, 0x450187e2), LEPT_UINT64_C2(0x27fb2b80, 0x668b24c5),
+    LEPT_UINT64_C2(0xb484f9dc, 0x9641e9da), LEPT_UINT64_C2(0xb1f9f660, 0x802dedf6),
+    LEPT_UINT64_C2(0xe1a63853, 0xbbd26451), LEPT_UINT64_C2(0x5e7873f8, 0xa0396973),
+    LEPT_UINT64_C2(0x8d07e334, 0x55637eb2), LEPT_UINT64_C2(0xdb0b487b, 0x6423e1e8),
+    LEPT_UINT64_C2(0xb049dc01, 0x6abc5e5f), LEPT_UINT64_C2(0x91ce1a9a, 0x3d2cda62),
+    LEPT_UINT64_C2(0xdc5c5301, 0xc56b75f7), LEPT_UINT64_C2(0x7641a140, 0xcc7810fb),
+    LEPT_UINT64_C2(0x89b9b3e1, 0x1b6329ba), LEPT_UINT64_C2(0xa9e904c8, 0x7fcb0a9d),
+    LEPT_UINT64_C2(0xac2820d9, 0x623bf429), LEPT_UINT64_C2(0x546345fa, 0x9fbdcd44),
+    LEPT_UINT64_C2(0xd732290f, 0xbacaf133), LEPT_UINT64_C2(0xa97c1779, 0x47ad4095),
+    LEPT_UINT64_C2(0x867f59a9, 0xd4bed6c0), LEPT_UINT64_C2(0x49ed8eab, 0xcccc485d),
+    LEPT_UINT64_C2(0xa81f3014, 0x49ee8c70), LEPT_UINT64_C2(0x5c68f256, 0xbfff5a74),
+    LEPT_UINT64_C2(0xd226fc19, 0x5c6a2f8c), LEPT_UINT64_C2(0x73832eec, 0x6fff3111),
+    LEPT_UINT64_C2(0x83585d8f, 0xd9c25db7), LEPT_UINT64_C2(0xc831fd53, 0xc5ff7eab),
+    LEPT_UINT64_C2(0xa42e74f3, 0xd032f525), LEPT_UINT64_C2(0xba3e7ca8, 0xb77f5e55),
+    LEPT_UINT64_C2(0xcd3a1230, 0xc43fb26f), LEPT_UINT64_C2(0x28ce1bd2, 0xe55f35eb),
+    LEPT_UINT64_C2(0x80444b5e, 0x7aa7cf85), LEPT_UINT64_C2(0x7980d163, 0xcf5b81b3),
+    LEPT_UINT64_C2(0xa0555e36, 0x1951c366), LEPT_UINT64_C2(0xd7e105bc, 0xc332621f),
+    LEPT_UINT64_C2(0xc86ab5c3, 0x9fa63440), LEPT_UINT64_C2(0x8dd9472b, 0xf3fefaa7),
+    LEPT_UINT64_C2(0xfa856334, 0x878fc150), LEPT_UINT64_C2(0xb14f98f6, 0xf0feb951),
+    LEPT_UINT64_C2(0x9c935e00, 0xd4b9d8d2), LEPT_UINT64_C2(0x6ed1bf9a, 0x569f33d3),
+    LEPT_UINT64_C2(0xc3b83581, 0x09e84f07), LEPT_UINT64_C2(0x0a862f80, 0xec4700c8),
+    LEPT_UINT64_C2(0xf4a642e1, 0x4c6262c8), LEPT_UINT64_C2(0xcd27bb61, 0x2758c0fa),
+    LEPT_UINT64_C2(0x98e7e9cc, 0xcfbd7dbd), LEPT_UINT64_C2(0x8038d51c, 0xb897789c),
+    LEPT_UINT64_C2(0xbf21e440, 0x03acdd2c), LEPT_UINT64_C2(0xe0470a63, 0xe6bd56c3),
+    LEPT_UINT64_C2(0xeeea5d50, 0x04981478), LEPT_UINT64_C2(0x1858ccfc, 0xe06cac74),
+    LEPT_UINT64_C2(0x95527a52, 0x02df0ccb), LEPT_UINT64_C2(0x0f37801e, 0x0c43ebc8),
+    LEPT_UINT64_C2(0xbaa718e6, 0x8396cffd), LEPT_UINT64_C2(0xd3056025, 0x8f54e6ba),
+    LEPT_UINT64_C2(0xe950df20, 0x247c83fd), LEPT_UINT64_C2(0x47c6b82e, 0xf32a2069),
+    LEPT_UINT64_C2(0x91d28b74, 0x16cdd27e), LEPT_UINT64_C2(0x4cdc331d, 0x57fa5441),
+    LEPT_UINT64_C2(0xb6472e51, 0x1c81471d), LEPT_UINT64_C2(0xe0133fe4, 0xadf8e952),
+    LEPT_UINT64_C2(0xe3d8f9e5, 0x63a198e5), LEPT_UINT64_C2(0x58180fdd, 0xd97723a6),
+    LEPT_UINT64_C2(0x8e679c2f, 0x5e44ff8f), LEPT_UINT64_C2(0x570f09ea, 0xa7ea7648)
+};
+
+/* 64x64 to 128-bit multiplication, returns the high word */
+static lept_uint64 lept_mul128(lept_uint64 x, lept_uint64 y, lept_uint64* lo) {
+#if defined(__SIZEOF_INT128__)
+    __extension__ typedef unsigned __int128 lept_uint128;
+    lept_uint128 r = (lept_uint128)x * y;
+    *lo = (lept_uint64)r;
+    return (lept_uint64)(r >> 64);
+#else
+    const lept_uint64 M32 = 0xFFFFFFFF;
+    lept_uint64 a = x >> 32, b = x & M32, c = y >> 32, d = y & M32;
+    lept_uint64 ac = a * c, bc = b * c, ad = a * d, bd = b * d;
+    lept_uint64 mid = (bd >> 32) + (ad & M32) + (bc & M32);
+    *lo = (mid << 32) | (bd & M32);
+    return ac + (ad >> 32) + (bc >> 32) + (mid >> 32);
+#endif
+}
+
+/* Eisel-Lemire: rounds w * 10^q from the truncated 128-bit product of w and 5^q.
+   Returns 0 when the product is too close to a rounding boundary to decide. */
+static int lept_eisel_lemire(lept_uint64 w, int q, double* d) {
+    const lept_uint64* p5;
+    lept_uint64 hi, lo, hi2, lo2, mantissa, bits;
+    int lz = 0, upper, e2, t;
+    if (w == 0 || q < -342) {
+        *d = 0.0;
+        return 1;
+    }
+    if (q > 308) {
+        *d = HUGE_VAL;
+        return 1;
+    }
+    if (!(w >> 32)) { w <<= 32; lz += 32; }
+    if (!(w >> 48)) { w <<= 16; lz += 16; }
+    if (!(w >> 56)) { w <<= 8;  lz += 8;  }
+    if (!(w >> 60)) { w <<= 4;  lz += 4;  }
+    if (!(w >> 62)) { w <<= 2;  lz += 2;  }
+    if (!(w >> 63)) { w <<= 1;  lz += 1;  }
+    p5 = lept_pow5_128 + 2 * (q + 342);
+    hi = lept_mul128(w, p5[0], &lo);
+    if ((hi & 0x1FF) == 0x1FF) { /* the truncated low word of 5^q may still carry into the result */
+        hi2 = lept_mul128(w, p5[1], &lo2);
+        lo += hi2;
+        if (lo < hi2)
+            hi++;
+    }
+    if (lo == ~(lept_uint64)0 && (q < -27 || q > 55)) /* 5^q is only exact in 128 bits for -27 <= q <= 55 */
+        return 0;
+    upper = (int)(hi >> 63);
+    mantissa = hi >> (upper + 9); /* 54 bits: the significand and a rounding bit */
+    t = 217706 * q; /* q * log2(10) in 16.16 fixed point, floored below */
+    e2 = (t >= 0 ? t >> 16 : -((-t + 65535) >> 16)) + 63 + upper - lz + 0x3FF;
+    if (e2 <= 0) { /* subnormal */
+        if (-e2 + 1 >= 64) {
+            *d = 0.0;
+            return 1;
+        }
+        mantissa >>= -e2 + 1;
+        mantissa += mantissa & 1;
+        mantissa >>= 1;
+        e2 = mantissa < LEPT_DP_HIDDEN_BIT ? 0 : 1;
+    }
+    else {
+        /* an exact halfway product rounds to even instead of up */
+        if (lo <= 1 && q >= -4 && q <= 23 && (mantissa & 3) == 1 && (mantissa << (upper + 9)) == hi)
+            mantissa &= ~(lept_uint64)1;
+        mantissa += mantissa & 1;
+        mantissa >>= 1;
+        if (mantissa >= LEPT_DP_HIDDEN_BIT << 1) {
+            mantissa = LEPT_DP_HIDDEN_BIT;
+            e2++;
+        }
+        mantissa &= ~LEPT_DP_HIDDEN_BIT;
+        if (e2 >= 0x7FF) {
+            *d = HUGE_VAL;
+            return 1;
+        }
+    }
+    bits = mantissa | (lept_uint64)e2 << 52;
+    memcpy(d, &bits, sizeof(*d));
+    return 1;
+}
+
+/* Converts m * 10^e10 to the nearest double; truncated means nonzero digits after the 19th were dropped from m */
+static int lept_decimal_to_double(lept_uint64 m, int e10, int truncated, double* d) {
+    double d1;
+    if (truncated) /* the exact value lies between m and m + 1 */
+        return lept_eisel_lemire(m, e10, d) && lept_eisel_lemire(m + 1, e10, &d1) && *d == d1;
+    if (m <= LEPT_UINT64_C2(0x00200000, 0x00000000) && lept_fast_number((double)m, e10, d))
+        return 1;
+    return lept_eisel_lemire(m, e10, d);
 }
 
-static int lept_parse_number(lept_context* c, lept_value* v) {
+static int lept_parse_number(lept_context* c) {
     const char* p = c->json;
-    if (*p == '-') p++;
-    if (*p == '0') p++;
+    lept_uint64 m = 0;
+    double n;
+    int truncated = 0, neg = 0, e10 = 0;
+    size_t len;
+    if (NUMC(p) == '-') { neg = 1; p++; }
+    if (NUMC(p) == '0') p++;
     else {
-        if (!ISDIGIT1TO9(*p)) return LEPT_PARSE_INVALID_VALUE;
-        for (p++; ISDIGIT(*p); p++);
+        if (!ISDIGIT1TO9(NUMC(p))) return LEPT_PARSE_INVALID_VALUE;
+        for (; ISDIGIT(NUMC(p)); p++) NUMD(p, 0);
     }
-    if (*p == '.') {
+    if (NUMC(p) == '.') {
         p++;
-        if (!ISDIGIT(*p)) return LEPT_PARSE_INVALID_VALUE;
-        for (p++; ISDIGIT(*p); p++);
+        if (!ISDIGIT(NUMC(p))) return LEPT_PARSE_INVALID_VALUE;
+        for (; ISDIGIT(NUMC(p)); p++) NUMD(p, 1);
     }
-    if (*p == 'e' || *p == 'E') {
+    if (NUMC(p) == 'e' || NUMC(p) == 'E') {
+        int e = 0, eneg = 0;
         p++;
-        if (*p == '+' || *p == '-') p++;
-        if (!ISDIGIT(*p)) return LEPT_PARSE_INVALID_VALUE;
-        for (p++; ISDIGIT(*p); p++);
-    }
-    errno = 0;
-    v->u.n = strtod(c->json, NULL);
-    if (errno == ERANGE && (v->u.n == HUGE_VAL || v->u.n == -HUGE_VAL))
-        return LEPT_PARSE_NUMBER_TOO_BIG;
-    v->type = LEPT_NUMBER;
+        if (NUMC(p) == '+') p++;
+        else if (NUMC(p) == '-') { eneg = 1; p++; }
+        if (!ISDIGIT(NUMC(p))) return LEPT_PARSE_INVALID_VALUE;
+        for (; ISDIGIT(NUMC(p)); p++)
+            if (e < 10000)
+                e = e * 10 + (*p - '0');
+        e10 += eneg ? -e : e;
+    }
+    if (lept_decimal_to_double(m, e10, truncated, &n)) {
+        if (n == HUGE_VAL)
+            return LEPT_PARSE_NUMBER_TOO_BIG;
+        if (neg)
+            n = -n;
+    }
+    else {
+        /* Undecided roundings go to strtod(), which needs a terminator that a length-delimited input may not have */
+        len = p - c->json;
+        PUTS(c, c->json, len);
+        PUTC(c, '\0');
+        errno = 0;
+        n = strtod(c->stack + c->top - len - 1, NULL);
+        lept_context_pop(c, len + 1);
+        if (errno == ERANGE && (n == HUGE_VAL || n == -HUGE_VAL))
+            return LEPT_PARSE_NUMBER_TOO_BIG;
+    }
     c->json = p;
-    return LEPT_PARSE_OK;
+    return c->handler->on_number(c->user, n);
 }
 
-static const char* lept_parse_hex4(const char* p, unsigned* u) {
+static const char* lept_parse_hex4(const char* p, const char* end, unsigned* u) {
     int i;
+    if (end - p < 4)
+        return NULL;
     *u = 0;
     for (i = 0; i < 4; i++) {
         char ch = *p++;
@@ -110,330 +1404,1848 @@ static const char* lept_parse_hex4(const char* p, unsigned* u) {
     return p;
 }
 
-static void lept_encode_utf8(lept_context* c, unsigned u) {
+static char* lept_encode_utf8(char* p, unsigned u) {
     if (u <= 0x7F) 
-        PUTC(c, u & 0xFF);
+        *p++ = u & 0xFF;
     else if (u <= 0x7FF) {
-        PUTC(c, 0xC0 | ((u >> 6) & 0xFF));
-        PUTC(c, 0x80 | ( u       & 0x3F));
+        *p++ = 0xC0 | ((u >> 6) & 0xFF);
+        *p++ = 0x80 | ( u       & 0x3F);
     }
     else if (u <= 0xFFFF) {
-        PUTC(c, 0xE0 | ((u >> 12) & 0xFF));
-        PUTC(c, 0x80 | ((u >>  6) & 0x3F));
-        PUTC(c, 0x80 | ( u        & 0x3F));
+        *p++ = 0xE0 | ((u >> 12) & 0xFF);
+        *p++ = 0x80 | ((u >>  6) & 0x3F);
+        *p++ = 0x80 | ( u        & 0x3F);
     }
     else {
         assert(u <= 0x10FFFF);
-        PUTC(c, 0xF0 | ((u >> 18) & 0xFF));
-        PUTC(c, 0x80 | ((u >> 12) & 0x3F));
-        PUTC(c, 0x80 | ((u >>  6) & 0x3F));
-        PUTC(c, 0x80 | ( u        & 0x3F));
+        *p++ = 0xF0 | ((u >> 18) & 0xFF);
+        *p++ = 0x80 | ((u >> 12) & 0x3F);
+        *p++ = 0x80 | ((u >>  6) & 0x3F);
+        *p++ = 0x80 | ( u        & 0x3F);
     }
+    return p;
 }
 
 #define STRING_ERROR(ret) do { c->top = head; return ret; } while(0)
+/* in situ the unescaped string is written back over its source, which is never shorter */
+#define STRING_PUTC(ch)   do { if (dst) *dst++ = (ch); else PUTC(c, ch); } while(0)
 
 static int lept_parse_string_raw(lept_context* c, char** str, size_t* len) {
     size_t head = c->top;
     unsigned u, u2;
     const char* p;
+    char* dst;
     EXPECT(c, '\"');
     p = c->json;
+    dst = c->insitu ? (char*)p : NULL;
     for (;;) {
-        char ch = *p++;
-        switch (ch) {
+        char ch;
+        const char* q = lept_scan_string(p, c->end);
+        if (q != p) {
+            /* copy the whole run of unescaped characters at once */
+            if (!dst)
+                PUTS(c, p, q - p);
+            else {
+                if (dst != p)
+                    memmove(dst, p, q - p);
+                dst += q - p;
+            }
+            p = q;
+        }
+        if (p == c->end)
+            STRING_ERROR(LEPT_PARSE_MISS_QUOTATION_MARK);
+        switch (ch = *p++) {
             case '\"':
-                *len = c->top - head;
-                *str = lept_context_pop(c, *len);
+                if (dst) {
+                    *str = (char*)c->json;
+                    *len = dst - *str;
+                    *dst = '\0';
+                }
+                else {
+                    *len = c->top - head;
+                    *str = lept_context_pop(c, *len);
+                }
                 c->json = p;
                 return LEPT_PARSE_OK;
             case '\\':
+                if (p == c->end)
+                    STRING_ERROR(LEPT_PARSE_INVALID_STRING_ESCAPE);
                 switch (*p++) {
-                    case '\"': PUTC(c, '\"'); break;
-                    case '\\': PUTC(c, '\\'); break;
-                    case '/':  PUTC(c, '/' ); break;
-                    case 'b':  PUTC(c, '\b'); break;
-                    case 'f':  PUTC(c, '\f'); break;
-                    case 'n':  PUTC(c, '\n'); break;
-                    case 'r':  PUTC(c, '\r'); break;
-                    case 't':  PUTC(c, '\t'); break;
+                    case '\"': STRING_PUTC('\"'); break;
+                    case '\\': STRING_PUTC('\\'); break;
+                    case '/':  STRING_PUTC('/' ); break;
+                    case 'b':  STRING_PUTC('\b'); break;
+                    case 'f':  STRING_PUTC('\f'); break;
+                    case 'n':  STRING_PUTC('\n'); break;
+                    case 'r':  STRING_PUTC('\r'); break;
+                    case 't':  STRING_PUTC('\t'); break;
                     case 'u':
-                        if (!(p = lept_parse_hex4(p, &u)))
+                        if (!(p = lept_parse_hex4(p, c->end, &u)))
                             STRING_ERROR(LEPT_PARSE_INVALID_UNICODE_HEX);
                         if (u >= 0xD800 && u <= 0xDBFF) { /* surrogate pair */
-                            if (*p++ != '\\')
+                            if (c->end - p < 2 || *p++ != '\\')
                                 STRING_ERROR(LEPT_PARSE_INVALID_UNICODE_SURROGATE);
                             if (*p++ != 'u')
                                 STRING_ERROR(LEPT_PARSE_INVALID_UNICODE_SURROGATE);
-                            if (!(p = lept_parse_hex4(p, &u2)))
+                            if (!(p = lept_parse_hex4(p, c->end, &u2)))
                                 STRING_ERROR(LEPT_PARSE_INVALID_UNICODE_HEX);
                             if (u2 < 0xDC00 || u2 > 0xDFFF)
                                 STRING_ERROR(LEPT_PARSE_INVALID_UNICODE_SURROGATE);
                             u = (((u - 0xD800) << 10) | (u2 - 0xDC00)) + 0x10000;
                         }
-                        lept_encode_utf8(c, u);
+                        if (dst)
+                            dst = lept_encode_utf8(dst, u);
+                        else {
+                            char buffer[4];
+                            PUTS(c, buffer, lept_encode_utf8(buffer, u) - buffer);
+                        }
                         break;
                     default:
                         STRING_ERROR(LEPT_PARSE_INVALID_STRING_ESCAPE);
                 }
                 break;
-            case '\0':
-                STRING_ERROR(LEPT_PARSE_MISS_QUOTATION_MARK);
             default:
-                if ((unsigned char)ch < 0x20)
-                    STRING_ERROR(LEPT_PARSE_INVALID_STRING_CHAR);
-                PUTC(c, ch);
+                assert((unsigned char)ch < 0x20);
+                STRING_ERROR(LEPT_PARSE_INVALID_STRING_CHAR);
         }
     }
 }
 
-static int lept_parse_string(lept_context* c, lept_value* v) {
+static int lept_parse_string(lept_context* c) {
     int ret;
     char* s;
     size_t len;
-    if ((ret = lept_parse_string_raw(c, &s, &len)) == LEPT_PARSE_OK)
-        lept_set_string(v, s, len);
-    return ret;
+    if ((ret = lept_parse_string_raw(c, &s, &len)) != LEPT_PARSE_OK)
+        return ret;
+    return c->handler->on_string(c->user, s, len);
 }
 
-static int lept_parse_value(lept_context* c, lept_value* v);
+static int lept_parse_value(lept_context* c);
+static int lept_parse_lazy(lept_context* c);
 
-static int lept_parse_array(lept_context* c, lept_value* v) {
-    size_t i, size = 0;
+static int lept_parse_array(lept_context* c) {
+    size_t size = 0;
     int ret;
     EXPECT(c, '[');
+    if (++c->depth > c->max_depth)
+        return LEPT_PARSE_NESTING_TOO_DEEP;
+    if ((ret = c->handler->on_start_array(c->user)) != LEPT_PARSE_OK)
+        return ret;
     lept_parse_whitespace(c);
-    if (*c->json == ']') {
+    if (PEEK(c) == ']') {
         c->json++;
-        lept_set_array(v, 0);
-        return LEPT_PARSE_OK;
+        c->depth--;
+        return c->handler->on_end_array(c->user, 0);
     }
     for (;;) {
-        lept_value e;
-        lept_init(&e);
-        if ((ret = lept_parse_value(c, &e)) != LEPT_PARSE_OK)
-            break;
-        memcpy(lept_context_push(c, sizeof(lept_value)), &e, sizeof(lept_value));
+        if ((ret = lept_parse_value(c)) != LEPT_PARSE_OK)
+            return ret;
         size++;
         lept_parse_whitespace(c);
-        if (*c->json == ',') {
+        if (PEEK(c) == ',') {
             c->json++;
             lept_parse_whitespace(c);
         }
-        else if (*c->json == ']') {
+        else if (PEEK(c) == ']') {
             c->json++;
-            lept_set_array(v, size);
-            memcpy(v->u.a.e, lept_context_pop(c, size * sizeof(lept_value)), size * sizeof(lept_value));
-            v->u.a.size = size;
-            return LEPT_PARSE_OK;
-        }
-        else {
-            ret = LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET;
-            break;
+            c->depth--;
+            return c->handler->on_end_array(c->user, size);
         }
+        else
+            return LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET;
     }
-    /* Pop and free values on the stack */
-    for (i = 0; i < size; i++)
-        lept_free((lept_value*)lept_context_pop(c, sizeof(lept_value)));
-    return ret;
 }
 
-static int lept_parse_object(lept_context* c, lept_value* v) {
-    size_t i, size;
-    lept_member m;
+static int lept_parse_object(lept_context* c) {
+    size_t size = 0;
     int ret;
     EXPECT(c, '{');
+    if (++c->depth > c->max_depth)
+        return LEPT_PARSE_NESTING_TOO_DEEP;
+    if ((ret = c->handler->on_start_object(c->user)) != LEPT_PARSE_OK)
+        return ret;
     lept_parse_whitespace(c);
-    if (*c->json == '}') {
+    if (PEEK(c) == '}') {
         c->json++;
-        lept_set_object(v, 0);
-        return LEPT_PARSE_OK;
+        c->depth--;
+        return c->handler->on_end_object(c->user, 0);
     }
-    m.k = NULL;
-    size = 0;
     for (;;) {
         char* str;
-        lept_init(&m.v);
+        size_t len;
         /* parse key */
-        if (*c->json != '"') {
-            ret = LEPT_PARSE_MISS_KEY;
-            break;
-        }
-        if ((ret = lept_parse_string_raw(c, &str, &m.klen)) != LEPT_PARSE_OK)
-            break;
-        memcpy(m.k = (char*)malloc(m.klen + 1), str, m.klen);
-        m.k[m.klen] = '\0';
+        if (PEEK(c) != '"')
+            return LEPT_PARSE_MISS_KEY;
+        if ((ret = lept_parse_string_raw(c, &str, &len)) != LEPT_PARSE_OK)
+            return ret;
+        if ((ret = c->handler->on_key(c->user, str, len)) != LEPT_PARSE_OK)
+            return ret;
         /* parse ws colon ws */
         lept_parse_whitespace(c);
-        if (*c->json != ':') {
-            ret = LEPT_PARSE_MISS_COLON;
-            break;
-        }
+        if (PEEK(c) != ':')
+            return LEPT_PARSE_MISS_COLON;
         c->json++;
         lept_parse_whitespace(c);
         /* parse value */
-        if ((ret = lept_parse_value(c, &m.v)) != LEPT_PARSE_OK)
-            break;
-        memcpy(lept_context_push(c, sizeof(lept_member)), &m, sizeof(lept_member));
+        if ((ret = lept_parse_value(c)) != LEPT_PARSE_OK)
+            return ret;
         size++;
-        m.k = NULL; /* ownership is transferred to member on stack */
         /* parse ws [comma | right-curly-brace] ws */
         lept_parse_whitespace(c);
-        if (*c->json == ',') {
+        if (PEEK(c) == ',') {
             c->json++;
             lept_parse_whitespace(c);
         }
-        else if (*c->json == '}') {
+        else if (PEEK(c) == '}') {
             c->json++;
-            lept_set_object(v, size);
-            memcpy(v->u.o.m, lept_context_pop(c, sizeof(lept_member) * size), sizeof(lept_member) * size);
-            v->u.o.size = size;
-            return LEPT_PARSE_OK;
+            c->depth--;
+            return c->handler->on_end_object(c->user, size);
         }
-        else {
-            ret = LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET;
-            break;
-        }
-    }
-    /* Pop and free members on the stack */
-    free(m.k);
-    for (i = 0; i < size; i++) {
-        lept_member* m = (lept_member*)lept_context_pop(c, sizeof(lept_member));
-        free(m->k);
-        lept_free(&m->v);
+        else
+            return LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET;
     }
-    v->type = LEPT_NULL;
-    return ret;
 }
 
-static int lept_parse_value(lept_context* c, lept_value* v) {
+static int lept_parse_value(lept_context* c) {
+    if (c->json == c->end)
+        return LEPT_PARSE_EXPECT_VALUE;
     switch (*c->json) {
-        case 't':  return lept_parse_literal(c, v, "true", LEPT_TRUE);
-        case 'f':  return lept_parse_literal(c, v, "false", LEPT_FALSE);
-        case 'n':  return lept_parse_literal(c, v, "null", LEPT_NULL);
-        default:   return lept_parse_number(c, v);
-        case '"':  return lept_parse_string(c, v);
-        case '[':  return lept_parse_array(c, v);
-        case '{':  return lept_parse_object(c, v);
-        case '\0': return LEPT_PARSE_EXPECT_VALUE;
+        case 't':  return lept_parse_literal(c, "true", LEPT_TRUE);
+        case 'f':  return lept_parse_literal(c, "false", LEPT_FALSE);
+        case 'n':  return lept_parse_literal(c, "null", LEPT_NULL);
+        default:   return lept_parse_number(c);
+        case '"':  return lept_parse_string(c);
+        case '[':  return c->lazy && c->depth > 0 ? lept_parse_lazy(c) : lept_parse_array(c);
+        case '{':  return c->lazy && c->depth > 0 ? lept_parse_lazy(c) : lept_parse_object(c);
     }
 }
 
-int lept_parse(lept_value* v, const char* json) {
-    lept_context c;
+static void lept_context_init(lept_context* c, const char* json, size_t len) {
+    c->json = json;
+    c->end = json + len;
+    c->stack = NULL;
+    c->size = c->top = 0;
+    c->arena = NULL;
+    c->insitu = 0;
+    c->handler = NULL;
+    c->user = NULL;
+    c->depth = 0;
+    c->max_depth = LEPT_PARSE_MAX_DEPTH;
+    c->engine = LEPT_PARSE_ENGINE;
+    c->lazy = 0;
+}
+
+static int lept_parse_document(lept_context* c) {
     int ret;
-    assert(v != NULL);
-    c.json = json;
-    c.stack = NULL;
-    c.size = c.top = 0;
-    lept_init(v);
-    lept_parse_whitespace(&c);
-    if ((ret = lept_parse_value(&c, v)) == LEPT_PARSE_OK) {
-        lept_parse_whitespace(&c);
-        if (*c.json != '\0') {
-            v->type = LEPT_NULL;
+    lept_parse_whitespace(c);
+    if ((ret = lept_parse_value(c)) == LEPT_PARSE_OK) {
+        lept_parse_whitespace(c);
+        if (c->json != c->end)
             ret = LEPT_PARSE_ROOT_NOT_SINGULAR;
-        }
     }
-    assert(c.top == 0);
-    free(c.stack);
     return ret;
 }
 
-static void lept_stringify_string(lept_context* c, const char* s, size_t len) {
-    static const char hex_digits[] = { '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F' };
-    size_t i, size;
-    char* head, *p;
-    assert(s != NULL);
-    p = head = lept_context_push(c, size = len * 6 + 2); /* "\u00xx..." */
-    *p++ = '"';
-    for (i = 0; i < len; i++) {
-        unsigned char ch = (unsigned char)s[i];
-        switch (ch) {
-            case '\"': *p++ = '\\'; *p++ = '\"'; break;
-            case '\\': *p++ = '\\'; *p++ = '\\'; break;
-            case '\b': *p++ = '\\'; *p++ = 'b';  break;
-            case '\f': *p++ = '\\'; *p++ = 'f';  break;
-            case '\n': *p++ = '\\'; *p++ = 'n';  break;
-            case '\r': *p++ = '\\'; *p++ = 'r';  break;
-            case '\t': *p++ = '\\'; *p++ = 't';  break;
-            default:
-                if (ch < 0x20) {
-                    *p++ = '\\'; *p++ = 'u'; *p++ = '0'; *p++ = '0';
-                    *p++ = hex_digits[ch >> 4];
-                    *p++ = hex_digits[ch & 15];
+/* States and open containers of the parsers that run the grammar as a state machine. */
+enum {
+    LEPT_PARSER_VALUE,          /* expecting a value */
+    LEPT_PARSER_ARRAY_FIRST,    /* after '[': a value or ']' */
+    LEPT_PARSER_OBJECT_FIRST,   /* after '{': a key or '}' */
+    LEPT_PARSER_KEY,            /* after ',' in an object */
+    LEPT_PARSER_COLON,          /* after a key */
+    LEPT_PARSER_AFTER_VALUE     /* ',' or the end of the container (or of the document) */
+};
+
+typedef struct {
+    size_t size;    /* values so far */
+    char type;      /* '[' or '{' */
+}lept_parser_level;
+
+/* the error for anything but ',' or the closing bracket after a value */
+static int lept_parser_after_value_error(const lept_parser_level* levels, size_t depth) {
+    if (depth == 0)
+        return LEPT_PARSE_ROOT_NOT_SINGULAR;
+    return levels[depth - 1].type == '[' ? LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET : LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET;
+}
+
+/* Stage 2 of the indexed engine walks the tokens of stage 1. A scalar is parsed where it
+   starts and must then be followed by whitespace up to the next token; structural tokens are
+   single characters, with nothing but whitespace up to the next token by construction. As
+   the input is valid up to the first error, it meets and reports the same one as the
+   recursive engine. */
+static int lept_parse_indexed(lept_context* c) {
+    const char* json = c->json;
+    lept_parser_level* levels = NULL;
+    size_t* tokens;
+    size_t n, k = 0, depth = 0, capacity = 0;
+    int state = LEPT_PARSER_VALUE, ret = LEPT_PARSE_OK;
+    tokens = lept_index_tokens(json, c->end - json, &n);
+    while (ret == LEPT_PARSE_OK && k < n) {
+        char ch = json[tokens[k]];
+        int scalar = 0, close = 0, done = 0;
+        switch (state) {
+            case LEPT_PARSER_ARRAY_FIRST:
+            case LEPT_PARSER_OBJECT_FIRST:
+                if (ch == (state == LEPT_PARSER_ARRAY_FIRST ? ']' : '}')) {
+                    k++;
+                    close = 1;
+                    break;
+                }
+                state = state == LEPT_PARSER_ARRAY_FIRST ? LEPT_PARSER_VALUE : LEPT_PARSER_KEY;
+                break;
+            case LEPT_PARSER_VALUE:
+                c->json = json + tokens[k++];
+                switch (ch) {
+                    case '[':
+                    case '{':
+                        if (depth == c->max_depth) {
+                            ret = LEPT_PARSE_NESTING_TOO_DEEP;
+                            break;
+                        }
+                        if (depth == capacity) {
+                            capacity = capacity == 0 ? 16 : capacity + (capacity >> 1);
+                            levels = (lept_parser_level*)realloc(levels, capacity * sizeof(lept_parser_level));
+                        }
+                        levels[depth].size = 0;
+                        levels[depth++].type = ch;
+                        state = ch == '[' ? LEPT_PARSER_ARRAY_FIRST : LEPT_PARSER_OBJECT_FIRST;
+                        ret = ch == '[' ? c->handler->on_start_array(c->user) : c->handler->on_start_object(c->user);
+                        break;
+                    case 't':  ret = lept_parse_literal(c, "true", LEPT_TRUE); scalar = 1; break;
+                    case 'f':  ret = lept_parse_literal(c, "false", LEPT_FALSE); scalar = 1; break;
+                    case 'n':  ret = lept_parse_literal(c, "null", LEPT_NULL); scalar = 1; break;
+                    case '"':  ret = lept_parse_string(c); scalar = 1; break;
+                    default:   ret = lept_parse_number(c); scalar = 1; break;
+                }
+                break;
+            case LEPT_PARSER_KEY:
+                if (ch != '"')
+                    ret = LEPT_PARSE_MISS_KEY;
+                else {
+                    char* str;
+                    size_t len;
+                    c->json = json + tokens[k++];
+                    if ((ret = lept_parse_string_raw(c, &str, &len)) == LEPT_PARSE_OK)
+                        ret = c->handler->on_key(c->user, str, len);
+                    scalar = 1;
+                }
+                break;
+            case LEPT_PARSER_COLON:
+                if (ch != ':')
+                    ret = LEPT_PARSE_MISS_COLON;
+                k++;
+                state = LEPT_PARSER_VALUE;
+                break;
+            case LEPT_PARSER_AFTER_VALUE:
+                if (depth > 0 && ch == ',') {
+                    k++;
+                    state = levels[depth - 1].type == '[' ? LEPT_PARSER_VALUE : LEPT_PARSER_KEY;
+                }
+                else if (depth > 0 && ch == (levels[depth - 1].type == '[' ? ']' : '}')) {
+                    k++;
+                    close = 1;
                 }
                 else
-                    *p++ = s[i];
+                    ret = lept_parser_after_value_error(levels, depth);
+                break;
+        }
+        if (close) {
+            depth--;
+            ret = levels[depth].type == '[' ? c->handler->on_end_array(c->user, levels[depth].size) :
+                c->handler->on_end_object(c->user, levels[depth].size);
+            done = 1;
+        }
+        else if (scalar && ret == LEPT_PARSE_OK) {
+            lept_parse_whitespace(c);
+            if (c->json != (k < n ? json + tokens[k] : c->end)) /* e.g. "0123", "truex": not a separator */
+                ret = state == LEPT_PARSER_KEY ? LEPT_PARSE_MISS_COLON : lept_parser_after_value_error(levels, depth);
+            else if (state == LEPT_PARSER_KEY)
+                state = LEPT_PARSER_COLON;
+            else
+                done = 1;
+        }
+        if (done && ret == LEPT_PARSE_OK) {
+            if (depth > 0)
+                levels[depth - 1].size++;
+            state = LEPT_PARSER_AFTER_VALUE;
         }
     }
-    *p++ = '"';
-    c->top -= size - (p - head);
+    if (ret == LEPT_PARSE_OK) {
+        switch (state) {
+            case LEPT_PARSER_VALUE:
+            case LEPT_PARSER_ARRAY_FIRST:   ret = LEPT_PARSE_EXPECT_VALUE; break;
+            case LEPT_PARSER_OBJECT_FIRST:
+            case LEPT_PARSER_KEY:           ret = LEPT_PARSE_MISS_KEY; break;
+            case LEPT_PARSER_COLON:         ret = LEPT_PARSE_MISS_COLON; break;
+            default:
+                if (depth > 0)
+                    ret = lept_parser_after_value_error(levels, depth);
+        }
+    }
+    free(levels);
+    free(tokens);
+    return ret;
 }
 
-static void lept_stringify_value(lept_context* c, const lept_value* v) {
-    size_t i;
-    switch (v->type) {
-        case LEPT_NULL:   PUTS(c, "null",  4); break;
-        case LEPT_FALSE:  PUTS(c, "false", 5); break;
-        case LEPT_TRUE:   PUTS(c, "true",  4); break;
-        case LEPT_NUMBER: c->top -= 32 - sprintf(lept_context_push(c, 32), "%.17g", v->u.n); break;
-        case LEPT_STRING: lept_stringify_string(c, v->u.s.s, v->u.s.len); break;
-        case LEPT_ARRAY:
-            PUTC(c, '[');
-            for (i = 0; i < v->u.a.size; i++) {
-                if (i > 0)
-                    PUTC(c, ',');
-                lept_stringify_value(c, &v->u.a.e[i]);
-            }
-            PUTC(c, ']');
-            break;
-        case LEPT_OBJECT:
-            PUTC(c, '{');
-            for (i = 0; i < v->u.o.size; i++) {
-                if (i > 0)
-                    PUTC(c, ',');
-                lept_stringify_string(c, v->u.o.m[i].k, v->u.o.m[i].klen);
-                PUTC(c, ':');
-                lept_stringify_value(c, &v->u.o.m[i].v);
-            }
-            PUTC(c, '}');
-            break;
-        default: assert(0 && "invalid type");
-    }
+static int lept_sax_skip(void* user) { (void)user; return LEPT_PARSE_OK; }
+static int lept_sax_skip_bool(void* user, int b) { (void)user; (void)b; return LEPT_PARSE_OK; }
+static int lept_sax_skip_number(void* user, double n) { (void)user; (void)n; return LEPT_PARSE_OK; }
+static int lept_sax_skip_string(void* user, const char* s, size_t len) { (void)user; (void)s; (void)len; return LEPT_PARSE_OK; }
+static int lept_sax_skip_end(void* user, size_t size) { (void)user; (void)size; return LEPT_PARSE_OK; }
+
+static const lept_handler lept_skip_handler = {
+    lept_sax_skip, lept_sax_skip_bool, lept_sax_skip_number, lept_sax_skip_string,
+    lept_sax_skip, lept_sax_skip_string, lept_sax_skip_end,
+    lept_sax_skip, lept_sax_skip_end
+};
+
+/* unset callbacks are replaced so the parser never has to test for them */
+static void lept_handler_fill(lept_handler* filled, const lept_handler* h) {
+    filled->on_null         = h->on_null         ? h->on_null         : lept_sax_skip;
+    filled->on_bool         = h->on_bool         ? h->on_bool         : lept_sax_skip_bool;
+    filled->on_number       = h->on_number       ? h->on_number       : lept_sax_skip_number;
+    filled->on_string       = h->on_string       ? h->on_string       : lept_sax_skip_string;
+    filled->on_start_object = h->on_start_object ? h->on_start_object : lept_sax_skip;
+    filled->on_key          = h->on_key          ? h->on_key          : lept_sax_skip_string;
+    filled->on_end_object   = h->on_end_object   ? h->on_end_object   : lept_sax_skip_end;
+    filled->on_start_array  = h->on_start_array  ? h->on_start_array  : lept_sax_skip;
+    filled->on_end_array    = h->on_end_array    ? h->on_end_array    : lept_sax_skip_end;
 }
 
-char* lept_stringify(const lept_value* v, size_t* length) {
+int lept_parse_sax(const lept_handler* h, void* user, const char* json, size_t len) {
     lept_context c;
-    assert(v != NULL);
-    c.stack = (char*)malloc(c.size = LEPT_PARSE_STRINGIFY_INIT_SIZE);
-    c.top = 0;
-    lept_stringify_value(&c, v);
-    if (length)
-        *length = c.top;
-    PUTC(&c, '\0');
-    return c.stack;
+    lept_handler filled;
+    int ret;
+    assert(h != NULL && (json != NULL || len == 0));
+    lept_handler_fill(&filled, h);
+    lept_context_init(&c, json, len);
+    c.handler = &filled;
+    c.user = user;
+    ret = lept_parse_document(&c);
+    free(c.stack);
+    return ret;
 }
 
-void lept_copy(lept_value* dst, const lept_value* src) {
-    assert(src != NULL && dst != NULL && src != dst);
-    switch (src->type) {
-        case LEPT_STRING:
-            lept_set_string(dst, src->u.s.s, src->u.s.len);
-            break;
-        case LEPT_ARRAY:
-            /* \todo */
+/* The DOM parser is a handler whose user data is the context itself: values are
+   built on the context stack and containers collect them when they end. */
+
+static lept_value* lept_dom_push(void* user) {
+    return (lept_value*)lept_context_push((lept_context*)user, sizeof(lept_value));
+}
+
+static int lept_dom_null(void* user) {
+    lept_dom_push(user)->type = LEPT_NULL;
+    return LEPT_PARSE_OK;
+}
+
+static int lept_dom_bool(void* user, int b) {
+    lept_dom_push(user)->type = b ? LEPT_TRUE : LEPT_FALSE;
+    return LEPT_PARSE_OK;
+}
+
+static int lept_dom_number(void* user, double n) {
+    lept_value* v = lept_dom_push(user);
+    v->u.n = n;
+    v->type = LEPT_NUMBER;
+    return LEPT_PARSE_OK;
+}
+
+/* also used for keys, which stay on the stack as strings until their object ends */
+static void lept_set_short_string(lept_value* v, const char* s, size_t len) {
+    assert(len <= LEPT_SHORT_STRING_MAX);
+    if (len)
+        memcpy(v->u.ss.s, s, len);
+    v->u.ss.s[len] = '\0';
+    LEPT_SHORT_STRING_LENGTH(v) = (unsigned char)len;
+    v->type = LEPT_STRING;
+    v->flags = LEPT_SHORT_STRING;
+}
+
+static int lept_dom_string(void* user, const char* s, size_t len) {
+    lept_context* c = (lept_context*)user;
+    lept_value temp;
+    /* s may live in the popped part of the stack, so copy it before pushing */
+    if (len <= LEPT_SHORT_STRING_MAX)
+        lept_set_short_string(&temp, s, len);
+    else {
+        temp.u.s.s = lept_context_strdup(c, s, len);
+        LEPT_LONG_STRING_LENGTH(&temp) = len;
+        temp.type = LEPT_STRING;
+        temp.flags = c->arena || c->insitu ? LEPT_BORROWED_DATA : 0;
+    }
+    memcpy(lept_dom_push(user), &temp, sizeof(lept_value));
+    return LEPT_PARSE_OK;
+}
+
+/* keys stay on the stack as long strings until their object ends */
+static int lept_dom_key(void* user, const char* s, size_t len) {
+    lept_context* c = (lept_context*)user;
+    char* str = lept_context_strdup(c, s, len);
+    lept_value* v = lept_dom_push(user);
+    v->u.s.s = str;
+    LEPT_LONG_STRING_LENGTH(v) = len;
+    v->type = LEPT_STRING;
+    v->flags = c->arena || c->insitu ? LEPT_BORROWED_DATA : 0;
+    return LEPT_PARSE_OK;
+}
+
+static int lept_dom_start(void* user) {
+    (void)user;
+    return LEPT_PARSE_OK;
+}
+
+static int lept_dom_end_array(void* user, size_t size) {
+    lept_context* c = (lept_context*)user;
+    lept_value* e = NULL;
+    lept_value* v;
+    size_t i;
+    if (size > 0) {
+        e = (lept_value*)lept_context_alloc(c, size * sizeof(lept_value));
+        memcpy(e, lept_context_pop(c, size * sizeof(lept_value)), size * sizeof(lept_value));
+    }
+    v = lept_dom_push(user);
+    v->u.a.e = e;
+    LEPT_ARRAY_SIZE(v) = size;
+    LEPT_SET_ARRAY_CAPACITY(v, size);
+    v->type = LEPT_ARRAY;
+    v->flags = c->arena && e ? LEPT_BORROWED_DATA : 0;
+    for (i = 0; c->insitu && i < size; i++)
+        if (e[i].type == LEPT_STRING ? e[i].flags & LEPT_BORROWED_DATA :
+            (e[i].type == LEPT_ARRAY || e[i].type == LEPT_OBJECT) && (e[i].flags & LEPT_BORROWED_TEXT)) {
+            v->flags |= LEPT_BORROWED_TEXT;
             break;
-        case LEPT_OBJECT:
-            /* \todo */
+        }
+    return LEPT_PARSE_OK;
+}
+
+static int lept_dom_end_object(void* user, size_t size) {
+    lept_context* c = (lept_context*)user;
+    lept_member* m = NULL;
+    lept_value* v;
+    size_t i, extra = 0;
+    if (size > 0) {
+        /* keys and values alternate on the stack */
+        lept_value* kv = (lept_value*)lept_context_pop(c, 2 * size * sizeof(lept_value));
+        /* an arena block cannot grow an index later, so build it now */
+        if (c->arena && size >= LEPT_OBJECT_INDEX_MIN_SIZE)
+            extra = lept_object_index_size(size) * sizeof(size_t);
+        m = (lept_member*)lept_context_alloc(c, sizeof(lept_member) * size + extra);
+        for (i = 0; i < size; i++) {
+            m[i].k = kv[2 * i].u.s.s;
+            m[i].klen = LEPT_LONG_STRING_LENGTH(&kv[2 * i]);
+            memcpy(&m[i].v, &kv[2 * i + 1], sizeof(lept_value));
+        }
+    }
+    v = lept_dom_push(user);
+    v->u.o.m = m;
+    LEPT_OBJECT_SIZE(v) = size;
+    LEPT_SET_OBJECT_CAPACITY(v, size);
+    v->type = LEPT_OBJECT;
+    v->flags = m ? (c->arena ? LEPT_BORROWED_DATA : 0) | (c->arena || c->insitu ? LEPT_BORROWED_KEYS : 0) |
+        (c->insitu ? LEPT_BORROWED_TEXT : 0) : 0;
+    if (extra)
+        lept_object_index_fill(v);
+    return LEPT_PARSE_OK;
+}
+
+static const lept_handler lept_dom_handler = {
+    lept_dom_null, lept_dom_bool, lept_dom_number, lept_dom_string,
+    lept_dom_start, lept_dom_key, lept_dom_end_object,
+    lept_dom_start, lept_dom_end_array
+};
+
+static void lept_dom_discard(lept_context* c) {
+    /* Pop and free values (and keys) of unfinished containers */
+    while (c->top > 0)
+        lept_free((lept_value*)lept_context_pop(c, sizeof(lept_value)));
+}
+
+/* Returns the end of the valid array or object at p, found by balancing brackets outside strings,
+   or NULL if the text ends first (it changed after it was checked). */
+static const char* lept_skip_container(const char* p, const char* end) {
+    size_t depth = 0;
+    while (p != end) {
+        switch (*p++) {
+            case '[':
+            case '{':
+                depth++;
+                break;
+            case ']':
+            case '}':
+                if (--depth == 0)
+                    return p;
+                break;
+            case '\"':
+                /* valid strings have no control characters, so this stops at '"' or '\\' */
+                while ((p = lept_scan_string(p, end)) != end && *p == '\\' && end - p > 2)
+                    p += 2;
+                if (p == end || *p == '\\')
+                    return NULL;
+                p++;
+                break;
+            default:
+                break;
+        }
+    }
+    return NULL;
+}
+
+/* Pushes an array or object below the root of a lazy parse as its text. */
+static int lept_parse_lazy(lept_context* c) {
+    const char* json = c->json;
+    lept_value* v;
+    if (c->lazy == LEPT_LAZY_CHECK) {
+        int ret;
+        c->handler = &lept_skip_handler;
+        c->lazy = 0;
+        ret = *json == '[' ? lept_parse_array(c) : lept_parse_object(c);
+        c->handler = &lept_dom_handler;
+        c->lazy = LEPT_LAZY_CHECK;
+        if (ret != LEPT_PARSE_OK)
+            return ret;
+    }
+    else {
+        const char* end = lept_skip_container(json, c->end);
+        if (end == NULL)
+            return LEPT_PARSE_INVALID_VALUE;
+        c->json = end;
+    }
+    v = lept_dom_push(c);
+    v->u.l.json = json;
+    LEPT_LAZY_LENGTH(v) = c->json - json;
+    v->type = *json == '[' ? LEPT_ARRAY : LEPT_OBJECT;
+    v->flags = LEPT_LAZY;
+    return LEPT_PARSE_OK;
+}
+
+static int lept_parse_root(lept_context* c, lept_value* v) {
+    int ret;
+    c->handler = &lept_dom_handler;
+    c->user = c;
+    lept_init(v);
+    ret = c->engine == LEPT_ENGINE_INDEXED ? lept_parse_indexed(c) : lept_parse_document(c);
+    if (ret == LEPT_PARSE_OK)
+        memcpy(v, lept_context_pop(c, sizeof(lept_value)), sizeof(lept_value));
+    else
+        lept_dom_discard(c);
+    assert(c->top == 0);
+    free(c->stack);
+    return ret;
+}
+
+int lept_parse(lept_value* v, const char* json) {
+    lept_context c;
+    assert(v != NULL);
+    assert(json != NULL);
+    lept_context_init(&c, json, strlen(json));
+    return lept_parse_root(&c, v);
+}
+
+int lept_parse_n(lept_value* v, const char* json, size_t len) {
+    lept_context c;
+    assert(v != NULL && (json != NULL || len == 0));
+    lept_context_init(&c, json, len);
+    return lept_parse_root(&c, v);
+}
+
+int lept_parse_ex(lept_value* v, const char* json, size_t len, const lept_parse_options* opts) {
+    lept_context c;
+    assert(v != NULL && (json != NULL || len == 0) && opts != NULL);
+    lept_context_init(&c, json, len);
+    if (opts->max_depth)
+        c.max_depth = opts->max_depth;
+    if (opts->engine)
+        c.engine = opts->engine;
+    if (opts->lazy) {
+        c.lazy = LEPT_LAZY_CHECK;
+        c.engine = LEPT_ENGINE_RECURSIVE;
+    }
+    return lept_parse_root(&c, v);
+}
+
+int lept_parse_insitu(lept_value* v, char* json) {
+    lept_context c;
+    assert(v != NULL && json != NULL);
+    lept_context_init(&c, json, strlen(json));
+    c.insitu = 1;
+    c.engine = LEPT_ENGINE_RECURSIVE;
+    return lept_parse_root(&c, v);
+}
+
+int lept_parse_arena(lept_value* v, lept_arena* a, const char* json) {
+    lept_context c;
+    assert(v != NULL && a != NULL);
+    assert(json != NULL);
+    lept_context_init(&c, json, strlen(json));
+    c.arena = a;
+    return lept_parse_root(&c, v);
+}
+
+/* Parses a lazy array or object in place, leaving the arrays and objects in it lazy. What v
+   holds does not change, so this is done through const pointers too. */
+static void lept_load(const lept_value* v) {
+    lept_context c;
+    lept_type type = v->type;
+    if (!(v->flags & LEPT_LAZY))
+        return;
+    lept_context_init(&c, v->u.l.json, LEPT_LAZY_LENGTH(v));
+    c.lazy = LEPT_LAZY_SKIP;
+    c.engine = LEPT_ENGINE_RECURSIVE;
+    if (lept_parse_root(&c, (lept_value*)v) != LEPT_PARSE_OK) {
+        /* the text was valid when checked, so it changed since: load an empty container */
+        if (type == LEPT_ARRAY)
+            lept_set_array((lept_value*)v, 0);
+        else
+            lept_set_object((lept_value*)v, 0);
+    }
+}
+
+/* A tape is a single block: the lept_tape header, then the values in document order as
+   64-bit words with the lept_type in the top byte, then the strings, null-terminated.
+   Literals take one word. Numbers take a second word with the bits of the double, strings
+   (and keys) one with the length, after a first word holding the offset of the characters.
+   Arrays and objects take a second word with the element/member count, after a first word
+   holding the position just past their contents; elements, and keys each followed by their
+   value, come next. Positions count words from the first value, the root. */
+struct lept_tape {
+    size_t size;    /* words */
+};
+
+#define LEPT_TAPE_HEADER            LEPT_ARENA_ALIGN(sizeof(lept_tape))
+#define LEPT_TAPE_WORDS(t)          ((const lept_uint64*)((const char*)(t) + LEPT_TAPE_HEADER))
+#define LEPT_TAPE_STRINGS(t)        ((const char*)(LEPT_TAPE_WORDS(t) + (t)->size))
+#define LEPT_TAPE_WORD(type, x)     ((lept_uint64)(type) << 56 | (lept_uint64)(x))
+#define LEPT_TAPE_TYPE(w)           ((lept_type)((w) >> 56))
+#define LEPT_TAPE_PAYLOAD(w)        ((size_t)((w) & LEPT_UINT64_C2(0x00FFFFFF, 0xFFFFFFFF)))
+
+/* The tape parser is a handler writing words and strings to two growing buffers, which
+   become one block when the document ends. An open container links its first word to
+   the container around it until it ends and the word gets its final payload. */
+typedef struct {
+    lept_context words, strings;    /* used as buffers; words start with room for the header */
+    size_t open;                    /* position of the innermost open container */
+}lept_tape_builder;
+
+static size_t lept_tape_position(const lept_tape_builder* b) {
+    return (b->words.top - LEPT_TAPE_HEADER) / sizeof(lept_uint64);
+}
+
+static lept_uint64* lept_tape_word(lept_tape_builder* b, size_t pos) {
+    return (lept_uint64*)(b->words.stack + LEPT_TAPE_HEADER) + pos;
+}
+
+static void lept_tape_put(lept_tape_builder* b, lept_uint64 w) {
+    *(lept_uint64*)lept_context_push(&b->words, sizeof(lept_uint64)) = w;
+}
+
+static int lept_tape_null(void* user) {
+    lept_tape_put((lept_tape_builder*)user, LEPT_TAPE_WORD(LEPT_NULL, 0));
+    return LEPT_PARSE_OK;
+}
+
+static int lept_tape_bool(void* user, int b) {
+    lept_tape_put((lept_tape_builder*)user, LEPT_TAPE_WORD(b ? LEPT_TRUE : LEPT_FALSE, 0));
+    return LEPT_PARSE_OK;
+}
+
+static int lept_tape_number(void* user, double n) {
+    lept_tape_builder* b = (lept_tape_builder*)user;
+    lept_uint64 bits;
+    memcpy(&bits, &n, sizeof(bits));
+    lept_tape_put(b, LEPT_TAPE_WORD(LEPT_NUMBER, 0));
+    lept_tape_put(b, bits);
+    return LEPT_PARSE_OK;
+}
+
+/* also used for keys */
+static int lept_tape_string(void* user, const char* s, size_t len) {
+    lept_tape_builder* b = (lept_tape_builder*)user;
+    char* d;
+    lept_tape_put(b, LEPT_TAPE_WORD(LEPT_STRING, b->strings.top));
+    lept_tape_put(b, (lept_uint64)len);
+    d = (char*)lept_context_push(&b->strings, len + 1);
+    if (len)
+        memcpy(d, s, len);
+    d[len] = '\0';
+    return LEPT_PARSE_OK;
+}
+
+static void lept_tape_start(lept_tape_builder* b, lept_type type) {
+    size_t pos = lept_tape_position(b);
+    lept_tape_put(b, LEPT_TAPE_WORD(type, b->open));
+    lept_tape_put(b, 0);
+    b->open = pos;
+}
+
+static void lept_tape_end(lept_tape_builder* b, lept_type type, size_t size) {
+    lept_uint64* w = lept_tape_word(b, b->open);
+    b->open = LEPT_TAPE_PAYLOAD(w[0]);
+    w[0] = LEPT_TAPE_WORD(type, lept_tape_position(b));
+    w[1] = (lept_uint64)size;
+}
+
+static int lept_tape_start_object(void* user) {
+    lept_tape_start((lept_tape_builder*)user, LEPT_OBJECT);
+    return LEPT_PARSE_OK;
+}
+
+static int lept_tape_end_object(void* user, size_t size) {
+    lept_tape_end((lept_tape_builder*)user, LEPT_OBJECT, size);
+    return LEPT_PARSE_OK;
+}
+
+static int lept_tape_start_array(void* user) {
+    lept_tape_start((lept_tape_builder*)user, LEPT_ARRAY);
+    return LEPT_PARSE_OK;
+}
+
+static int lept_tape_end_array(void* user, size_t size) {
+    lept_tape_end((lept_tape_builder*)user, LEPT_ARRAY, size);
+    return LEPT_PARSE_OK;
+}
+
+int lept_parse_tape(lept_tape** t, const char* json, size_t len) {
+    static const lept_handler tape = {
+        lept_tape_null, lept_tape_bool, lept_tape_number, lept_tape_string,
+        lept_tape_start_object, lept_tape_string, lept_tape_end_object,
+        lept_tape_start_array, lept_tape_end_array
+    };
+    lept_tape_builder b;
+    int ret;
+    assert(t != NULL && (json != NULL || len == 0));
+    b.words.stack = b.strings.stack = NULL;
+    b.words.size = b.words.top = b.strings.size = b.strings.top = 0;
+    b.open = 0;
+    lept_context_push(&b.words, LEPT_TAPE_HEADER);
+    *t = NULL;
+    if ((ret = lept_parse_sax(&tape, &b, json, len)) == LEPT_PARSE_OK) {
+        char* p = (char*)realloc(b.words.stack, b.words.top + b.strings.top);
+        if (b.strings.top)
+            memcpy(p + b.words.top, b.strings.stack, b.strings.top);
+        *t = (lept_tape*)p;
+        (*t)->size = (b.words.top - LEPT_TAPE_HEADER) / sizeof(lept_uint64);
+    }
+    else
+        free(b.words.stack);
+    free(b.strings.stack);
+    return ret;
+}
+
+void lept_tape_free(lept_tape* t) {
+    free(t);
+}
+
+lept_type lept_tape_get_type(const lept_tape* t, size_t v) {
+    assert(t != NULL && v < t->size);
+    return LEPT_TAPE_TYPE(LEPT_TAPE_WORDS(t)[v]);
+}
+
+size_t lept_tape_next(const lept_tape* t, size_t v) {
+    lept_uint64 w;
+    assert(t != NULL && v < t->size);
+    w = LEPT_TAPE_WORDS(t)[v];
+    switch (LEPT_TAPE_TYPE(w)) {
+        case LEPT_ARRAY:
+        case LEPT_OBJECT:  return LEPT_TAPE_PAYLOAD(w);
+        case LEPT_NUMBER:
+        case LEPT_STRING:  return v + 2;
+        default:           return v + 1;
+    }
+}
+
+int lept_tape_get_boolean(const lept_tape* t, size_t v) {
+    assert(t != NULL && v < t->size);
+    assert(LEPT_TAPE_TYPE(LEPT_TAPE_WORDS(t)[v]) == LEPT_TRUE || LEPT_TAPE_TYPE(LEPT_TAPE_WORDS(t)[v]) == LEPT_FALSE);
+    return LEPT_TAPE_TYPE(LEPT_TAPE_WORDS(t)[v]) == LEPT_TRUE;
+}
+
+double lept_tape_get_number(const lept_tape* t, size_t v) {
+    double n;
+    assert(t != NULL && v < t->size && LEPT_TAPE_TYPE(LEPT_TAPE_WORDS(t)[v]) == LEPT_NUMBER);
+    memcpy(&n, &LEPT_TAPE_WORDS(t)[v + 1], sizeof(n));
+    return n;
+}
+
+const char* lept_tape_get_string(const lept_tape* t, size_t v) {
+    assert(t != NULL && v < t->size && LEPT_TAPE_TYPE(LEPT_TAPE_WORDS(t)[v]) == LEPT_STRING);
+    return LEPT_TAPE_STRINGS(t) + LEPT_TAPE_PAYLOAD(LEPT_TAPE_WORDS(t)[v]);
+}
+
+size_t lept_tape_get_string_length(const lept_tape* t, size_t v) {
+    assert(t != NULL && v < t->size && LEPT_TAPE_TYPE(LEPT_TAPE_WORDS(t)[v]) == LEPT_STRING);
+    return (size_t)LEPT_TAPE_WORDS(t)[v + 1];
+}
+
+size_t lept_tape_get_array_size(const lept_tape* t, size_t v) {
+    assert(t != NULL && v < t->size && LEPT_TAPE_TYPE(LEPT_TAPE_WORDS(t)[v]) == LEPT_ARRAY);
+    return (size_t)LEPT_TAPE_WORDS(t)[v + 1];
+}
+
+size_t lept_tape_get_array_element(const lept_tape* t, size_t v, size_t index) {
+    assert(t != NULL && v < t->size && LEPT_TAPE_TYPE(LEPT_TAPE_WORDS(t)[v]) == LEPT_ARRAY);
+    assert(index < (size_t)LEPT_TAPE_WORDS(t)[v + 1]);
+    for (v += 2; index > 0; index--)
+        v = lept_tape_next(t, v);
+    return v;
+}
+
+size_t lept_tape_get_object_size(const lept_tape* t, size_t v) {
+    assert(t != NULL && v < t->size && LEPT_TAPE_TYPE(LEPT_TAPE_WORDS(t)[v]) == LEPT_OBJECT);
+    return (size_t)LEPT_TAPE_WORDS(t)[v + 1];
+}
+
+/* position of the key of member index */
+static size_t lept_tape_get_object_member(const lept_tape* t, size_t v, size_t index) {
+    assert(t != NULL && v < t->size && LEPT_TAPE_TYPE(LEPT_TAPE_WORDS(t)[v]) == LEPT_OBJECT);
+    assert(index < (size_t)LEPT_TAPE_WORDS(t)[v + 1]);
+    for (v += 2; index > 0; index--)
+        v = lept_tape_next(t, v + 2);
+    return v;
+}
+
+const char* lept_tape_get_object_key(const lept_tape* t, size_t v, size_t index) {
+    return lept_tape_get_string(t, lept_tape_get_object_member(t, v, index));
+}
+
+size_t lept_tape_get_object_key_length(const lept_tape* t, size_t v, size_t index) {
+    return lept_tape_get_string_length(t, lept_tape_get_object_member(t, v, index));
+}
+
+size_t lept_tape_get_object_value(const lept_tape* t, size_t v, size_t index) {
+    return lept_tape_get_object_member(t, v, index) + 2;
+}
+
+size_t lept_tape_find_object_value(const lept_tape* t, size_t v, const char* key, size_t klen) {
+    size_t i, size;
+    assert(t != NULL && v < t->size && LEPT_TAPE_TYPE(LEPT_TAPE_WORDS(t)[v]) == LEPT_OBJECT);
+    assert(key != NULL || klen == 0);
+    size = (size_t)LEPT_TAPE_WORDS(t)[v + 1];
+    for (i = 0, v += 2; i < size; i++, v = lept_tape_next(t, v + 2))
+        if (lept_tape_get_string_length(t, v) == klen && memcmp(lept_tape_get_string(t, v), key, klen) == 0)
+            return v + 2;
+    return LEPT_KEY_NOT_EXIST;
+}
+
+/* The push parser runs the grammar as a state machine over an explicit stack of open
+   containers, so it can stop at any chunk boundary. Only scalar tokens (strings, numbers,
+   literals) are not resumable: one split by a chunk boundary is kept in a pending buffer until
+   its end arrives and is then parsed whole by the ordinary token parsers. */
+
+struct lept_parser {
+    lept_context c;
+    lept_handler handler;
+    lept_parser_level* levels;
+    size_t depth, capacity;
+    char* pending;              /* start of a token split across chunks */
+    size_t pending_len, pending_size;
+    int state, ret, dom;
+    char token;                 /* kind of pending token: '"' string, 'x' other scalar, 0 none */
+    char escape;                /* pending string ends in an unfinished escape */
+};
+
+lept_parser* lept_parser_new(const lept_handler* h, void* user) {
+    lept_parser* p = (lept_parser*)malloc(sizeof(lept_parser));
+    lept_context_init(&p->c, "", 0);
+    if ((p->dom = (h == NULL))) {
+        p->c.handler = &lept_dom_handler;
+        p->c.user = &p->c;
+    }
+    else {
+        lept_handler_fill(&p->handler, h);
+        p->c.handler = &p->handler;
+        p->c.user = user;
+    }
+    p->levels = NULL;
+    p->depth = p->capacity = 0;
+    p->pending = NULL;
+    p->pending_len = p->pending_size = 0;
+    p->state = LEPT_PARSER_VALUE;
+    p->ret = LEPT_PARSE_OK;
+    p->token = p->escape = 0;
+    return p;
+}
+
+void lept_parser_free(lept_parser* p) {
+    assert(p != NULL);
+    /* Pop and free values of an unfinished document */
+    while (p->dom && p->c.top > 0)
+        lept_free((lept_value*)lept_context_pop(&p->c, sizeof(lept_value)));
+    free(p->c.stack);
+    free(p->levels);
+    free(p->pending);
+    free(p);
+}
+
+static void lept_parser_keep(lept_parser* p, const char* s, size_t len) {
+    if (p->pending_len + len > p->pending_size) {
+        if (p->pending_size == 0)
+            p->pending_size = LEPT_PARSE_STACK_INIT_SIZE;
+        while (p->pending_len + len > p->pending_size)
+            p->pending_size += p->pending_size >> 1;
+        p->pending = (char*)realloc(p->pending, p->pending_size);
+    }
+    memcpy(p->pending + p->pending_len, s, len);
+    p->pending_len += len;
+}
+
+/* Returns the end of the token continuing at q, or NULL when the chunk ends first. */
+static const char* lept_parser_token_end(lept_parser* p, const char* q, const char* end) {
+    if (p->token == '\"') {
+        if (p->escape) {
+            if (q == end)
+                return NULL;
+            q++;
+            p->escape = 0;
+        }
+        for (;;) {
+            if ((q = lept_scan_string(q, end)) == end)
+                return NULL;
+            if (*q != '\\')
+                return q + 1; /* closing quote, or a control character the string parser rejects */
+            if (++q == end) {
+                p->escape = 1;
+                return NULL;
+            }
+            q++;
+        }
+    }
+    for (; q != end; q++)
+        if (ISWHITESPACE(*q) || *q == ',' || *q == ':' || *q == '[' || *q == ']' || *q == '{' || *q == '}' || *q == '\"')
+            return q;
+    return NULL;
+}
+
+static void lept_parser_value_done(lept_parser* p) {
+    if (p->depth > 0)
+        p->levels[p->depth - 1].size++;
+    p->state = LEPT_PARSER_AFTER_VALUE;
+}
+
+static int lept_parser_open(lept_parser* p, char type) {
+    lept_context* c = &p->c;
+    if (p->depth == c->max_depth)
+        return LEPT_PARSE_NESTING_TOO_DEEP;
+    if (p->depth == p->capacity) {
+        p->capacity = p->capacity == 0 ? 16 : p->capacity + (p->capacity >> 1);
+        p->levels = (lept_parser_level*)realloc(p->levels, p->capacity * sizeof(lept_parser_level));
+    }
+    p->levels[p->depth].size = 0;
+    p->levels[p->depth++].type = type;
+    p->state = type == '[' ? LEPT_PARSER_ARRAY_FIRST : LEPT_PARSER_OBJECT_FIRST;
+    return type == '[' ? c->handler->on_start_array(c->user) : c->handler->on_start_object(c->user);
+}
+
+static int lept_parser_close(lept_parser* p) {
+    lept_context* c = &p->c;
+    lept_parser_level* l = &p->levels[--p->depth];
+    int ret = l->type == '[' ? c->handler->on_end_array(c->user, l->size) : c->handler->on_end_object(c->user, l->size);
+    lept_parser_value_done(p);
+    return ret;
+}
+
+/* Parses the complete scalar token [json, end), a value or a key depending on the state. */
+static int lept_parser_token(lept_parser* p, const char* json, const char* end) {
+    lept_context* c = &p->c;
+    int ret;
+    c->json = json;
+    c->end = end;
+    if (p->state == LEPT_PARSER_OBJECT_FIRST || p->state == LEPT_PARSER_KEY) {
+        char* str;
+        size_t len;
+        if ((ret = lept_parse_string_raw(c, &str, &len)) != LEPT_PARSE_OK)
+            return ret;
+        p->state = LEPT_PARSER_COLON;
+        return c->handler->on_key(c->user, str, len);
+    }
+    if ((ret = lept_parse_value(c)) != LEPT_PARSE_OK)
+        return ret;
+    if (c->json != end) /* e.g. "0123", "truex": what follows the value is not a separator */
+        return lept_parser_after_value_error(p->levels, p->depth);
+    lept_parser_value_done(p);
+    return LEPT_PARSE_OK;
+}
+
+static int lept_parser_run(lept_parser* p, const char* json, const char* end) {
+    lept_context* c = &p->c;
+    const char* q;
+    int ret;
+    char ch;
+    if (p->token) {
+        /* finish the token split by the previous chunk */
+        if (!(q = lept_parser_token_end(p, json, end))) {
+            lept_parser_keep(p, json, end - json);
+            return LEPT_PARSE_OK;
+        }
+        lept_parser_keep(p, json, q - json);
+        p->token = 0;
+        ret = lept_parser_token(p, p->pending, p->pending + p->pending_len);
+        p->pending_len = 0;
+        if (ret != LEPT_PARSE_OK)
+            return ret;
+        json = q;
+    }
+    c->json = json;
+    c->end = end;
+    for (;;) {
+        lept_parse_whitespace(c);
+        if (c->json == end)
+            return LEPT_PARSE_OK;
+        ch = *c->json;
+        switch (p->state) {
+            case LEPT_PARSER_COLON:
+                if (ch != ':')
+                    return LEPT_PARSE_MISS_COLON;
+                c->json++;
+                p->state = LEPT_PARSER_VALUE;
+                continue;
+            case LEPT_PARSER_AFTER_VALUE:
+                if (p->depth > 0 && ch == ',') {
+                    c->json++;
+                    p->state = p->levels[p->depth - 1].type == '[' ? LEPT_PARSER_VALUE : LEPT_PARSER_KEY;
+                    continue;
+                }
+                if (p->depth > 0 && ch == (p->levels[p->depth - 1].type == '[' ? ']' : '}')) {
+                    c->json++;
+                    if ((ret = lept_parser_close(p)) != LEPT_PARSE_OK)
+                        return ret;
+                    continue;
+                }
+                return lept_parser_after_value_error(p->levels, p->depth);
+            case LEPT_PARSER_ARRAY_FIRST:
+                if (ch == ']') {
+                    c->json++;
+                    if ((ret = lept_parser_close(p)) != LEPT_PARSE_OK)
+                        return ret;
+                    continue;
+                }
+                break;
+            case LEPT_PARSER_OBJECT_FIRST:
+                if (ch == '}') {
+                    c->json++;
+                    if ((ret = lept_parser_close(p)) != LEPT_PARSE_OK)
+                        return ret;
+                    continue;
+                }
+                /* fall through */
+            case LEPT_PARSER_KEY:
+                if (ch != '\"')
+                    return LEPT_PARSE_MISS_KEY;
+                break;
+        }
+        if (ch == '[' || ch == '{') {
+            c->json++;
+            if ((ret = lept_parser_open(p, ch)) != LEPT_PARSE_OK)
+                return ret;
+            continue;
+        }
+        /* scalar token, the first character always belongs to it */
+        p->token = ch == '\"' ? '\"' : 'x';
+        json = c->json;
+        if (!(q = lept_parser_token_end(p, json + 1, end))) {
+            lept_parser_keep(p, json, end - json);
+            return LEPT_PARSE_OK;
+        }
+        p->token = 0;
+        if ((ret = lept_parser_token(p, json, q)) != LEPT_PARSE_OK)
+            return ret;
+        c->end = end;
+    }
+}
+
+int lept_parser_feed(lept_parser* p, const char* chunk, size_t len) {
+    assert(p != NULL && (chunk != NULL || len == 0));
+    if (p->ret == LEPT_PARSE_OK && len > 0)
+        p->ret = lept_parser_run(p, chunk, chunk + len);
+    return p->ret;
+}
+
+int lept_parser_finish(lept_parser* p, lept_value* v) {
+    lept_context* c = &p->c;
+    assert(p != NULL);
+    if (v)
+        lept_init(v);
+    if (p->ret == LEPT_PARSE_OK && p->token) {
+        /* the end of input ends the pending token */
+        p->token = 0;
+        p->ret = lept_parser_token(p, p->pending, p->pending + p->pending_len);
+        p->pending_len = 0;
+    }
+    if (p->ret == LEPT_PARSE_OK) {
+        switch (p->state) {
+            case LEPT_PARSER_VALUE:
+            case LEPT_PARSER_ARRAY_FIRST:   p->ret = LEPT_PARSE_EXPECT_VALUE; break;
+            case LEPT_PARSER_OBJECT_FIRST:
+            case LEPT_PARSER_KEY:           p->ret = LEPT_PARSE_MISS_KEY; break;
+            case LEPT_PARSER_COLON:         p->ret = LEPT_PARSE_MISS_COLON; break;
+            default:
+                if (p->depth > 0)
+                    p->ret = lept_parser_after_value_error(p->levels, p->depth);
+        }
+    }
+    if (p->ret == LEPT_PARSE_OK && p->dom) {
+        lept_value* root = (lept_value*)lept_context_pop(c, sizeof(lept_value));
+        if (v)
+            memcpy(v, root, sizeof(lept_value));
+        else
+            lept_free(root);
+    }
+    return p->ret;
+}
+
+/* Grisu2 (Florian Loitsch, "Printing Floating-Point Numbers Quickly and Accurately with Integers")
+   produces the shortest digits that round-trip in nearly all cases, and digits that round-trip always;
+   lept_grisu_shorten() catches the rest. */
+
+typedef struct { lept_uint64 f; int e; } lept_diyfp; /* f * 2^e */
+
+static const lept_uint64 lept_cached_powers_f[] = { /* 10^-348, 10^-340, ..., 10^340 */
+    LEPT_UINT64_C2(0xfa8fd5a0, 0x081c0288), LEPT_UINT64_C2(0xbaaee17f, 0xa23ebf76), LEPT_UINT64_C2(0x8b16fb20, 0x3055ac76),
+    LEPT_UINT64_C2(0xcf42894a, 0x5dce35ea), LEPT_UINT64_C2(0x9a6bb0aa, 0x55653b2d), LEPT_UINT64_C2(0xe61acf03, 0x3d1a45df),
+    LEPT_UINT64_C2(0xab70fe17, 0xc79ac6ca), LEPT_UINT64_C2(0xff77b1fc, 0xbebcdc4f), LEPT_UINT64_C2(0xbe5691ef, 0x416bd60c),
+    LEPT_UINT64_C2(0x8dd01fad, 0x907ffc3c), LEPT_UINT64_C2(0xd3515c28, 0x31559a83), LEPT_UINT64_C2(0x9d71ac8f, 0xada6c9b5),
+    LEPT_UINT64_C2(0xea9c2277, 0x23ee8bcb), LEPT_UINT64_C2(0xaecc4991, 0x4078536d), LEPT_UINT64_C2(0x823c1279, 0x5db6ce57),
+    LEPT_UINT64_C2(0xc2109436, 0x4dfb5637), LEPT_UINT64_C2(0x9096ea6f, 0x3848984f), LEPT_UINT64_C2(0xd77485cb, 0x25823ac7),
+    LEPT_UINT64_C2(0xa086cfcd, 0x97bf97f4), LEPT_UINT64_C2(0xef340a98, 0x172aace5), LEPT_UINT64_C2(0xb23867fb, 0x2a35b28e),
+    LEPT_UINT64_C2(0x84c8d4df, 0xd2c63f3b), LEPT_UINT64_C2(0xc5dd4427, 0x1ad3cdba), LEPT_UINT64_C2(0x936b9fce, 0xbb25c996),
+    LEPT_UINT64_C2(0xdbac6c24, 0x7d62a584), LEPT_UINT64_C2(0xa3ab6658, 0x0d5fdaf6), LEPT_UINT64_C2(0xf3e2f893, 0xdec3f126),
+    LEPT_UINT64_C2(0xb5b5ada8, 0xaaff80b8), LEPT_UINT64_C2(0x87625f05, 0x6c7c4a8b), LEPT_UINT64_C2(0xc9bcff60, 0x34c13053),
+    LEPT_UINT64_C2(0x964e858c, 0x91ba2655), LEPT_UINT64_C2(0xdff97724, 0x70297ebd), LEPT_UINT64_C2(0xa6dfbd9f, 0xb8e5b88f),
+    LEPT_UINT64_C2(0xf8a95fcf, 0x88747d94), LEPT_UINT64_C2(0xb9447093, 0x8fa89bcf), LEPT_UINT64_C2(0x8a08f0f8, 0xbf0f156b),
+    LEPT_UINT64_C2(0xcdb02555, 0x653131b6), LEPT_UINT64_C2(0x993fe2c6, 0xd07b7fac), LEPT_UINT64_C2(0xe45c10c4, 0x2a2b3b06),
+    LEPT_UINT64_C2(0xaa242499, 0x697392d3), LEPT_UINT64_C2(0xfd87b5f2, 0x8300ca0e), LEPT_UINT64_C2(0xbce50864, 0x92111aeb),
+    LEPT_UINT64_C2(0x8cbccc09, 0x6f5088cc), LEPT_UINT64_C2(0xd1b71758, 0xe219652c), LEPT_UINT64_C2(0x9c400000, 0x00000000),
+    LEPT_UINT64_C2(0xe8d4a510, 0x00000000), LEPT_UINT64_C2(0xad78ebc5, 0xac620000), LEPT_UINT64_C2(0x813f3978, 0xf8940984),
+    LEPT_UINT64_C2(0xc097ce7b, 0xc90715b3), LEPT_UINT64_C2(0x8f7e32ce, 0x7bea5c70), LEPT_UINT64_C2(0xd5d238a4, 0xabe98068),
+    LEPT_UINT64_C2(0x9f4f2726, 0x179a2245), LEPT_UINT64_C2(0xed63a231, 0xd4c4fb27), LEPT_UINT64_C2(0xb0de6538, 0x8cc8ada8),
+    LEPT_UINT64_C2(0x83c7088e, 0x1aab65db), LEPT_UINT64_C2(0xc45d1df9, 0x42711d9a), LEPT_UINT64_C2(0x924d692c, 0xa61be758),
+    LEPT_UINT64_C2(0xda01ee64, 0x1a708dea), LEPT_UINT64_C2(0xa26da399, 0x9aef774a), LEPT_UINT64_C2(0xf209787b, 0xb47d6b85),
+    LEPT_UINT64_C2(0xb454e4a1, 0x79dd1877), LEPT_UINT64_C2(0x865b8692, 0x5b9bc5c2), LEPT_UINT64_C2(0xc83553c5, 0xc8965d3d),
+    LEPT_UINT64_C2(0x952ab45c, 0xfa97a0b3), LEPT_UINT64_C2(0xde469fbd, 0x99a05fe3), LEPT_UINT64_C2(0xa59bc234, 0xdb398c25),
+    LEPT_UINT64_C2(0xf6c69a72, 0xa3989f5c), LEPT_UINT64_C2(0xb7dcbf53, 0x54e9bece), LEPT_UINT64_C2(0x88fcf317, 0xf22241e2),
+    LEPT_UINT64_C2(0xcc20ce9b, 0xd35c78a5), LEPT_UINT64_C2(0x98165af3, 0x7b2153df), LEPT_UINT64_C2(0xe2a0b5dc, 0x971f303a),
+    LEPT_UINT64_C2(0xa8d9d153, 0x5ce3b396), LEPT_UINT64_C2(0xfb9b7cd9, 0xa4a7443c), LEPT_UINT64_C2(0xbb764c4c, 0xa7a44410),
+    LEPT_UINT64_C2(0x8bab8eef, 0xb6409c1a), LEPT_UINT64_C2(0xd01fef10, 0xa657842c), LEPT_UINT64_C2(0x9b10a4e5, 0xe9913129),
+    LEPT_UINT64_C2(0xe7109bfb, 0xa19c0c9d), LEPT_UINT64_C2(0xac2820d9, 0x623bf429), LEPT_UINT64_C2(0x80444b5e, 0x7aa7cf85),
+    LEPT_UINT64_C2(0xbf21e440, 0x03acdd2d), LEPT_UINT64_C2(0x8e679c2f, 0x5e44ff8f), LEPT_UINT64_C2(0xd433179d, 0x9c8cb841),
+    LEPT_UINT64_C2(0x9e19db92, 0xb4e31ba9), LEPT_UINT64_C2(0xeb96bf6e, 0xbadf77d9), LEPT_UINT64_C2(0xaf87023b, 0x9bf0ee6b)
+};
+
+static const short lept_cached_powers_e[] = {
+    -1220, -1193, -1166, -1140, -1113, -1087, -1060, -1034, -1007, -980, -954, -927, -901, -874, -847,
+    -821, -794, -768, -741, -715, -688, -661, -635, -608, -582, -555, -529, -502, -475, -449,
+    -422, -396, -369, -343, -316, -289, -263, -236, -210, -183, -157, -130, -103, -77, -50,
+    -24, 3, 30, 56, 83, 109, 136, 162, 189, 216, 242, 269, 295, 322, 348,
+    375, 402, 428, 455, 481, 508, 534, 561, 588, 614, 641, 667, 694, 720, 747,
+    774, 800, 827, 853, 880, 907, 933, 960, 986, 1013, 1039, 1066
+};
+
+static const lept_uint64 lept_pow10_u64[] = {
+    LEPT_UINT64_C2(0x00000000, 0x00000001), LEPT_UINT64_C2(0x00000000, 0x0000000a), LEPT_UINT64_C2(0x00000000, 0x00000064),
+    LEPT_UINT64_C2(0x00000000, 0x000003e8), LEPT_UINT64_C2(0x00000000, 0x00002710), LEPT_UINT64_C2(0x00000000, 0x000186a0),
+    LEPT_UINT64_C2(0x00000000, 0x000f4240), LEPT_UINT64_C2(0x00000000, 0x00989680), LEPT_UINT64_C2(0x00000000, 0x05f5e100),
+    LEPT_UINT64_C2(0x00000000, 0x3b9aca00), LEPT_UINT64_C2(0x00000002, 0x540be400), LEPT_UINT64_C2(0x00000017, 0x4876e800),
+    LEPT_UINT64_C2(0x000000e8, 0xd4a51000), LEPT_UINT64_C2(0x00000918, 0x4e72a000), LEPT_UINT64_C2(0x00005af3, 0x107a4000),
+    LEPT_UINT64_C2(0x00038d7e, 0xa4c68000), LEPT_UINT64_C2(0x002386f2, 0x6fc10000), LEPT_UINT64_C2(0x01634578, 0x5d8a0000),
+    LEPT_UINT64_C2(0x0de0b6b3, 0xa7640000), LEPT_UINT64_C2(0x8ac72304, 0x89e80000)
+
+};
+
+static lept_diyfp lept_diyfp_make(lept_uint64 f, int e) {
+    lept_diyfp ret;
+    ret.f = f;
+    ret.e = e;
+    return ret;
+}
+
+static lept_diyfp lept_diyfp_mul(lept_diyfp x, lept_diyfp y) {
+    const lept_uint64 M32 = 0xFFFFFFFF;
+    lept_uint64 a = x.f >> 32, b = x.f & M32, c = y.f >> 32, d = y.f & M32;
+    lept_uint64 ac = a * c, bc = b * c, ad = a * d, bd = b * d;
+    lept_uint64 tmp = (bd >> 32) + (ad & M32) + (bc & M32);
+    tmp += 1U << 31; /* round */
+    return lept_diyfp_make(ac + (ad >> 32) + (bc >> 32) + (tmp >> 32), x.e + y.e + 64);
+}
+
+/* Boundaries m- and m+ of a positive double v, normalized to the same exponent. */
+static void lept_diyfp_boundaries(lept_diyfp v, lept_diyfp* minus, lept_diyfp* plus) {
+    lept_diyfp pl = lept_diyfp_make((v.f << 1) + 1, v.e - 1), mi;
+    while (!(pl.f & (LEPT_DP_HIDDEN_BIT << 1))) {
+        pl.f <<= 1;
+        pl.e--;
+    }
+    pl.f <<= 64 - 52 - 2;
+    pl.e -= 64 - 52 - 2;
+    mi = v.f == LEPT_DP_HIDDEN_BIT ? lept_diyfp_make((v.f << 2) - 1, v.e - 2) : lept_diyfp_make((v.f << 1) - 1, v.e - 1);
+    mi.f <<= mi.e - pl.e;
+    mi.e = pl.e;
+    *minus = mi;
+    *plus = pl;
+}
+
+/* Cached 10^-K whose product with 2^e has its binary exponent in [-60, -32]. */
+static lept_diyfp lept_cached_power(int e, int* K) {
+    double dk = (-61 - e) * 0.30102999566398114 + 347; /* positive, so truncation then increment is ceil() */
+    int k = (int)dk;
+    unsigned index;
+    if (dk - k > 0.0)
+        k++;
+    index = (unsigned)((k >> 3) + 1);
+    *K = -(-348 + (int)(index << 3));
+    return lept_diyfp_make(lept_cached_powers_f[index], lept_cached_powers_e[index]);
+}
+
+static void lept_grisu_round(char* buffer, int len, lept_uint64 delta, lept_uint64 rest, lept_uint64 ten_kappa, lept_uint64 wp_w) {
+    while (rest < wp_w && delta - rest >= ten_kappa &&
+        (rest + ten_kappa < wp_w || wp_w - rest > rest + ten_kappa - wp_w)) { /* closer */
+        buffer[len - 1]--;
+        rest += ten_kappa;
+    }
+}
+
+static int lept_count_decimal_digit32(unsigned n) {
+    int i;
+    for (i = 1; i < 10 && n >= lept_pow10_u64[i]; i++);
+    return i;
+}
+
+static void lept_digit_gen(lept_diyfp W, lept_diyfp Mp, lept_uint64 delta, char* buffer, int* len, int* K) {
+    const lept_diyfp one = lept_diyfp_make((lept_uint64)1 << -Mp.e, Mp.e);
+    const lept_uint64 wp_w = Mp.f - W.f;
+    unsigned p1 = (unsigned)(Mp.f >> -one.e);
+    lept_uint64 p2 = Mp.f & (one.f - 1);
+    int kappa = lept_count_decimal_digit32(p1);
+    *len = 0;
+    while (kappa > 0) {
+        lept_uint64 tmp;
+        unsigned pow10 = (unsigned)lept_pow10_u64[kappa - 1];
+        unsigned d = p1 / pow10;
+        p1 %= pow10;
+        if (d || *len)
+            buffer[(*len)++] = (char)('0' + d);
+        kappa--;
+        tmp = ((lept_uint64)p1 << -one.e) + p2;
+        if (tmp <= delta) {
+            *K += kappa;
+            lept_grisu_round(buffer, *len, delta, tmp, lept_pow10_u64[kappa] << -one.e, wp_w);
+            return;
+        }
+    }
+    for (;;) {
+        char d;
+        p2 *= 10;
+        delta *= 10;
+        d = (char)(p2 >> -one.e);
+        if (d || *len)
+            buffer[(*len)++] = (char)('0' + d);
+        p2 &= one.f - 1;
+        kappa--;
+        if (p2 < delta) {
+            *K += kappa;
+            lept_grisu_round(buffer, *len, delta, p2, one.f, -kappa < 20 ? wp_w * lept_pow10_u64[-kappa] : 0);
+            return;
+        }
+    }
+}
+
+/* Digits of a positive finite double d = buffer[0..len) * 10^K. */
+static void lept_grisu2(double d, char* buffer, int* len, int* K) {
+    lept_uint64 bits;
+    lept_diyfp v, w_m, w_p, c_mk, W, Wp, Wm;
+    int biased_e;
+    memcpy(&bits, &d, sizeof(bits));
+    biased_e = (int)((bits & LEPT_DP_EXPONENT_MASK) >> 52);
+    if (biased_e != 0)
+        v = lept_diyfp_make((bits & LEPT_DP_SIGNIFICAND_MASK) + LEPT_DP_HIDDEN_BIT, biased_e - LEPT_DP_EXPONENT_BIAS);
+    else
+        v = lept_diyfp_make(bits & LEPT_DP_SIGNIFICAND_MASK, 1 - LEPT_DP_EXPONENT_BIAS);
+    lept_diyfp_boundaries(v, &w_m, &w_p);
+    c_mk = lept_cached_power(w_p.e, K);
+    while (!(v.f & LEPT_DP_SIGN_MASK)) {
+        v.f <<= 1;
+        v.e--;
+    }
+    W = lept_diyfp_mul(v, c_mk);
+    Wp = lept_diyfp_mul(w_p, c_mk);
+    Wm = lept_diyfp_mul(w_m, c_mk);
+    Wm.f++;
+    Wp.f--;
+    lept_digit_gen(W, Wp, Wp.f - Wm.f, buffer, len, K);
+}
+
+/* Grisu2 searches a slightly narrowed rounding interval, so for about 0.08% of doubles its
+   digits are one longer than needed: drop the last one while a rounding of the others still
+   converts back to d. Decimals of up to 15 digits convert to distinct doubles, so only 16 and
+   17 digits can shorten; and as the last digit is the nearest one, only the nearer rounding
+   can, unless that digit is 5 or the rounding interval of d is lopsided (a power of two). */
+static void lept_grisu_shorten(double d, char* buffer, int* len, int* K) {
+    lept_uint64 bits, m, c;
+    double r;
+    int i, up, tries;
+    memcpy(&bits, &d, sizeof(bits));
+    while (*len >= 16) {
+        for (m = 0, i = 0; i < *len - 1; i++)
+            m = m * 10 + (unsigned)(buffer[i] - '0');
+        up = buffer[*len - 1] >= '5';
+        tries = buffer[*len - 1] == '5' || !(bits & LEPT_DP_SIGNIFICAND_MASK) ? 2 : 1;
+        for (i = 0; i < tries; i++) {
+            c = m + (i == 0 ? up : !up);
+            if (lept_decimal_to_double(c, *K + 1, 0, &r) && r == d)
+                break;
+        }
+        if (i == tries)
+            return;
+        if (c == lept_pow10_u64[--*len]) { /* 99.9 rounded up to 100 */
+            *K += *len + 1;
+            *len = 1;
+            buffer[0] = '1';
+            return;
+        }
+        ++*K;
+        for (i = *len; i-- > 0; c /= 10)
+            buffer[i] = (char)('0' + c % 10);
+        while (buffer[*len - 1] == '0') {
+            --*len;
+            ++*K;
+        }
+    }
+}
+
+/* Writes d like "%.17g" does, but with the shortest digits that round-trip:
+   fixed notation for decimal exponents in [-4, 17), scientific otherwise. */
+static int lept_format_number(char* buffer, double d) {
+    char digits[20], *p = buffer;
+    int len, K, x;
+    lept_uint64 bits;
+    memcpy(&bits, &d, sizeof(bits));
+    if ((bits & LEPT_DP_EXPONENT_MASK) == LEPT_DP_EXPONENT_MASK)
+        return sprintf(buffer, "%.17g", d); /* inf and nan have no JSON representation anyway */
+    if (bits & LEPT_DP_SIGN_MASK) {
+        *p++ = '-';
+        d = -d;
+    }
+    if (d < 9007199254740992.0 && d == (double)(lept_uint64)d) {
+        /* integer fast path */
+        lept_uint64 u = (lept_uint64)d;
+        len = 0;
+        do {
+            digits[len++] = (char)('0' + u % 10);
+            u /= 10;
+        } while (u);
+        while (len > 0)
+            *p++ = digits[--len];
+        return (int)(p - buffer);
+    }
+    lept_grisu2(d, digits, &len, &K);
+    lept_grisu_shorten(d, digits, &len, &K);
+    x = len + K - 1; /* decimal exponent of the first digit */
+    if (x < -4 || x >= 17) {
+        /* 1.234e+20 */
+        *p++ = digits[0];
+        if (len > 1) {
+            *p++ = '.';
+            memcpy(p, digits + 1, len - 1);
+            p += len - 1;
+        }
+        *p++ = 'e';
+        *p++ = x < 0 ? '-' : '+';
+        if (x < 0)
+            x = -x;
+        if (x >= 100) {
+            *p++ = (char)('0' + x / 100);
+            x %= 100;
+        }
+        *p++ = (char)('0' + x / 10);
+        *p++ = (char)('0' + x % 10);
+    }
+    else if (x >= 0) {
+        /* 1234.5, 12340000 */
+        if (len <= x + 1) {
+            memcpy(p, digits, len);
+            memset(p + len, '0', x + 1 - len);
+            p += x + 1;
+        }
+        else {
+            memcpy(p, digits, x + 1);
+            p += x + 1;
+            *p++ = '.';
+            memcpy(p, digits + x + 1, len - x - 1);
+            p += len - x - 1;
+        }
+    }
+    else {
+        /* 0.0012345 */
+        *p++ = '0';
+        *p++ = '.';
+        memset(p, '0', -x - 1);
+        p += -x - 1;
+        memcpy(p, digits, len);
+        p += len;
+    }
+    return (int)(p - buffer);
+}
+
+void lept_writer_init(lept_writer* w, char* buf, size_t size, int (*flush)(lept_writer* w, size_t need), void* user) {
+    assert(w != NULL && buf != NULL && size > 0 && flush != NULL);
+    w->buf = buf;
+    w->size = size;
+    w->top = 0;
+    w->flush = flush;
+    w->user = user;
+    w->fd = -1;
+    w->error = 0;
+}
+
+static int lept_writer_flush_file(lept_writer* w, size_t need) {
+    (void)need;
+    if (fwrite(w->buf, 1, w->top, (FILE*)w->user) != w->top)
+        return -1;
+    w->top = 0;
+    return 0;
+}
+
+void lept_writer_init_file(lept_writer* w, FILE* f, char* buf, size_t size) {
+    assert(f != NULL);
+    lept_writer_init(w, buf, size, lept_writer_flush_file, f);
+}
+
+static int lept_writer_flush_fd(lept_writer* w, size_t need) {
+    size_t i;
+    (void)need;
+    for (i = 0; i < w->top; ) {
+        int n = (int)write(w->fd, w->buf + i, w->top - i);
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            return -1;
+        }
+        i += n;
+    }
+    w->top = 0;
+    return 0;
+}
+
+void lept_writer_init_fd(lept_writer* w, int fd, char* buf, size_t size) {
+    lept_writer_init(w, buf, size, lept_writer_flush_fd, NULL);
+    w->fd = fd;
+}
+
+static int lept_writer_grow(lept_writer* w, size_t need) {
+    if (w->top + need > w->size) {
+        while (w->top + need > w->size)
+            w->size += w->size >> 1;  /* w->size * 1.5 */
+        w->buf = (char*)realloc(w->buf, w->size);
+    }
+    return 0;
+}
+
+void lept_writer_init_buffer(lept_writer* w) {
+    lept_writer_init(w, (char*)malloc(LEPT_PARSE_STRINGIFY_INIT_SIZE), LEPT_PARSE_STRINGIFY_INIT_SIZE, lept_writer_grow, NULL);
+}
+
+static void lept_writer_flush(lept_writer* w, size_t need) {
+    if (!w->error)
+        w->error = w->flush(w, need);
+    if (w->error)
+        w->top = 0; /* the output is lost anyway, keep going without more calls */
+}
+
+static void lept_writer_write(lept_writer* w, const char* s, size_t len) {
+    size_t n;
+    while (len > (n = w->size - w->top)) {
+        memcpy(w->buf + w->top, s, n);
+        w->top += n;
+        s += n;
+        len -= n;
+        lept_writer_flush(w, len);
+    }
+    memcpy(w->buf + w->top, s, len);
+    w->top += len;
+}
+
+static void lept_stringify_string(lept_writer* w, const char* s, size_t len) {
+    static const char hex_digits[] = { '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F' };
+    const char* end = s + len;
+    char escape[6] = { '\\', 'u', '0', '0' };
+    assert(s != NULL);
+    WRITEC(w, '"');
+    for (;;) {
+        /* the characters to escape are the ones the string parser stops at */
+        const char* q = lept_scan_string(s, end);
+        unsigned char ch;
+        lept_writer_write(w, s, q - s);
+        if (q == end)
+            break;
+        switch (ch = (unsigned char)*q) {
+            case '\"': lept_writer_write(w, "\\\"", 2); break;
+            case '\\': lept_writer_write(w, "\\\\", 2); break;
+            case '\b': lept_writer_write(w, "\\b",  2); break;
+            case '\f': lept_writer_write(w, "\\f",  2); break;
+            case '\n': lept_writer_write(w, "\\n",  2); break;
+            case '\r': lept_writer_write(w, "\\r",  2); break;
+            case '\t': lept_writer_write(w, "\\t",  2); break;
+            default:
+                escape[4] = hex_digits[ch >> 4];
+                escape[5] = hex_digits[ch & 15];
+                lept_writer_write(w, escape, 6);
+        }
+        s = q + 1;
+    }
+    WRITEC(w, '"');
+}
+
+static void lept_stringify_value(lept_writer* w, const lept_value* v) {
+    size_t i;
+    switch (v->type) {
+        case LEPT_NULL:   lept_writer_write(w, "null",  4); break;
+        case LEPT_FALSE:  lept_writer_write(w, "false", 5); break;
+        case LEPT_TRUE:   lept_writer_write(w, "true",  4); break;
+        case LEPT_NUMBER:
+            if (w->size - w->top >= 32)
+                w->top += lept_format_number(w->buf + w->top, v->u.n);
+            else {
+                char buffer[32];
+                lept_writer_write(w, buffer, lept_format_number(buffer, v->u.n));
+            }
             break;
-        default:
-            lept_free(dst);
-            memcpy(dst, src, sizeof(lept_value));
+        case LEPT_STRING: lept_stringify_string(w, LEPT_STRING_DATA(v), LEPT_STRING_LENGTH(v)); break;
+        case LEPT_ARRAY:
+            lept_load(v);
+            WRITEC(w, '[');
+            for (i = 0; i < LEPT_ARRAY_SIZE(v); i++) {
+                if (i > 0)
+                    WRITEC(w, ',');
+                lept_stringify_value(w, &v->u.a.e[i]);
+            }
+            WRITEC(w, ']');
             break;
+        case LEPT_OBJECT:
+            lept_load(v);
+            WRITEC(w, '{');
+            for (i = 0; i < LEPT_OBJECT_SIZE(v); i++) {
+                if (i > 0)
+                    WRITEC(w, ',');
+                lept_stringify_string(w, v->u.o.m[i].k, v->u.o.m[i].klen);
+                WRITEC(w, ':');
+                lept_stringify_value(w, &v->u.o.m[i].v);
+            }
+            WRITEC(w, '}');
+            break;
+        default: assert(0 && "invalid type");
     }
 }
 
+int lept_stringify_to(const lept_value* v, lept_writer* w) {
+    assert(v != NULL && w != NULL);
+    lept_stringify_value(w, v);
+    lept_writer_flush(w, 0);
+    return w->error;
+}
+
+static size_t lept_stringify_string_size(const char* s, size_t len) {
+    const char* end = s + len;
+    size_t size = 2;
+    for (;;) {
+        const char* q = lept_scan_string(s, end);
+        size += q - s;
+        if (q == end)
+            return size;
+        switch (*q) {
+            case '\"': case '\\': case '\b': case '\f': case '\n': case '\r': case '\t':
+                size += 2; break;
+            default:
+                size += 6; /* \u00XX */
+        }
+        s = q + 1;
+    }
+}
+
+size_t lept_stringify_size(const lept_value* v) {
+    char buffer[32];
+    size_t i, size;
+    assert(v != NULL);
+    switch (v->type) {
+        case LEPT_NULL:
+        case LEPT_TRUE:   return 4;
+        case LEPT_FALSE:  return 5;
+        case LEPT_NUMBER: return lept_format_number(buffer, v->u.n);
+        case LEPT_STRING: return lept_stringify_string_size(LEPT_STRING_DATA(v), LEPT_STRING_LENGTH(v));
+        case LEPT_ARRAY:
+            lept_load(v);
+            size = LEPT_ARRAY_SIZE(v) > 0 ? LEPT_ARRAY_SIZE(v) + 1 : 2; /* brackets and commas */
+            for (i = 0; i < LEPT_ARRAY_SIZE(v); i++)
+                size += lept_stringify_size(&v->u.a.e[i]);
+            return size;
+        case LEPT_OBJECT:
+            lept_load(v);
+            size = LEPT_OBJECT_SIZE(v) > 0 ? 2 * LEPT_OBJECT_SIZE(v) + 1 : 2; /* braces, commas and colons */
+            for (i = 0; i < LEPT_OBJECT_SIZE(v); i++)
+                size += lept_stringify_string_size(v->u.o.m[i].k, v->u.o.m[i].klen) + lept_stringify_size(&v->u.o.m[i].v);
+            return size;
+        default: assert(0 && "invalid type"); return 0;
+    }
+}
+
+static int lept_writer_overflow(lept_writer* w, size_t need) {
+    (void)w;
+    (void)need;
+    return -1;
+}
+
+size_t lept_stringify_into(const lept_value* v, char* buf, size_t cap) {
+    lept_writer w;
+    assert(v != NULL && (buf != NULL || cap == 0));
+    if (cap > 0) {
+        lept_writer_init(&w, buf, cap, lept_writer_overflow, NULL);
+        lept_stringify_value(&w, v);
+        if (!w.error)
+            return w.top;
+    }
+    return lept_stringify_size(v);
+}
+
+char* lept_stringify(const lept_value* v, size_t* length) {
+    lept_writer w;
+    assert(v != NULL);
+    lept_writer_init_buffer(&w);
+    lept_stringify_value(&w, v);
+    if (length)
+        *length = w.top;
+    WRITEC(&w, '\0');
+    return w.buf;
+}
+
+static char* lept_strdup(const char* s, size_t len) {
+    char* ret = (char*)lept_block_alloc(len + 1);
+    memcpy(ret, s, len);
+    ret[len] = '\0';
+    return ret;
+}
+
+/* v holds a shallow copy: give it its own string, or queue its container on c */
+static void lept_copy_value(lept_context* c, lept_value* v) {
+    if (v->type == LEPT_STRING ? v->flags & LEPT_SHORT_STRING : (v->type == LEPT_ARRAY || v->type == LEPT_OBJECT) && (v->flags & LEPT_LAZY))
+        return; /* held in v itself, or refers to the parsed text */
+    v->flags = 0;
+    if (v->type == LEPT_STRING)
+        v->u.s.s = lept_strdup(v->u.s.s, LEPT_LONG_STRING_LENGTH(v));
+    else if (v->type == LEPT_ARRAY || v->type == LEPT_OBJECT)
+        *(lept_value**)lept_context_push(c, sizeof(lept_value*)) = v;
+}
+
+void lept_copy(lept_value* dst, const lept_value* src) {
+    lept_context c;
+    lept_value temp;
+    size_t i, n;
+    assert(src != NULL && dst != NULL && src != dst);
+    c.stack = NULL;
+    c.size = c.top = 0;
+    /* Every value is copied shallowly first, with its container's elements or members in one
+       memcpy(), then its own buffers are replaced, depth by depth with an explicit stack. */
+    memcpy(&temp, src, sizeof(lept_value));
+    lept_copy_value(&c, &temp);
+    while (c.top > 0) {
+        lept_value* v = *(lept_value**)lept_context_pop(&c, sizeof(lept_value*));
+        if (v->type == LEPT_ARRAY) {
+            lept_value* e = NULL;
+            if ((n = LEPT_ARRAY_SIZE(v)) > 0) {
+                e = (lept_value*)lept_block_alloc(n * sizeof(lept_value));
+                memcpy(e, v->u.a.e, n * sizeof(lept_value));
+                for (i = 0; i < n; i++)
+                    lept_copy_value(&c, &e[i]);
+            }
+            v->u.a.e = e;
+            LEPT_SET_ARRAY_CAPACITY(v, n);
+        }
+        else {
+            lept_member* m = NULL;
+            if ((n = LEPT_OBJECT_SIZE(v)) > 0) {
+                m = (lept_member*)lept_block_alloc(n * sizeof(lept_member));
+                memcpy(m, v->u.o.m, n * sizeof(lept_member));
+                for (i = 0; i < n; i++) {
+                    m[i].k = lept_strdup(m[i].k, m[i].klen);
+                    lept_copy_value(&c, &m[i].v);
+                }
+            }
+            v->u.o.m = m;
+            LEPT_SET_OBJECT_CAPACITY(v, n);
+        }
+    }
+    free(c.stack);
+    /* src may be part of dst */
+    lept_move(dst, &temp);
+}
+
+/* Adds a reference to the storage of v, which is about to be copied shallowly. Arena and in
+   situ strings, and arena containers or those holding in situ text, cannot be shared and are
+   copied instead. */
+static void lept_retain(lept_value* v) {
+    if (v->type == LEPT_STRING) {
+        if (v->flags & LEPT_BORROWED_DATA) {
+            v->u.s.s = lept_strdup(v->u.s.s, LEPT_LONG_STRING_LENGTH(v));
+            v->flags = 0;
+        }
+        else if (!(v->flags & LEPT_SHORT_STRING))
+            LEPT_REFCOUNT(v->u.s.s)++;
+    }
+    else if ((v->type == LEPT_ARRAY || v->type == LEPT_OBJECT) && !(v->flags & LEPT_LAZY)) {
+        if (v->flags & (LEPT_BORROWED_DATA | LEPT_BORROWED_TEXT)) {
+            lept_value temp;
+            lept_init(&temp);
+            lept_copy(&temp, v);
+            memcpy(v, &temp, sizeof(lept_value));
+        }
+        else if (v->type == LEPT_ARRAY ? v->u.a.e != NULL : v->u.o.m != NULL)
+            LEPT_REFCOUNT(v->type == LEPT_ARRAY ? (void*)v->u.a.e : (void*)v->u.o.m)++;
+    }
+}
+
+/* Gives v its own elements or members before they are modified. Their values are shared
+   with the old copy in turn, so only the path to a modification gets copied. */
+static void lept_unshare(lept_value* v) {
+    size_t i, capacity;
+    if (v->flags & LEPT_BORROWED_DATA)
+        return;
+    if (v->type == LEPT_ARRAY) {
+        lept_value* e = v->u.a.e;
+        if (e == NULL || LEPT_REFCOUNT(e) == 1)
+            return;
+        capacity = LEPT_ARRAY_CAPACITY(v);
+        v->u.a.e = (lept_value*)lept_block_alloc(capacity * sizeof(lept_value));
+        LEPT_SET_ARRAY_CAPACITY(v, capacity);
+        memcpy(v->u.a.e, e, LEPT_ARRAY_SIZE(v) * sizeof(lept_value));
+        for (i = 0; i < LEPT_ARRAY_SIZE(v); i++)
+            lept_retain(&v->u.a.e[i]);
+        LEPT_REFCOUNT(e)--;
+    }
+    else if (v->type == LEPT_OBJECT) {
+        lept_member* m = v->u.o.m;
+        size_t extra;
+        if (m == NULL || LEPT_REFCOUNT(m) == 1)
+            return;
+        capacity = LEPT_OBJECT_CAPACITY(v);
+        extra = v->flags & LEPT_OBJECT_INDEXED ? lept_object_index_size(capacity) * sizeof(size_t) : 0;
+        v->u.o.m = (lept_member*)lept_block_alloc(capacity * sizeof(lept_member) + extra);
+        LEPT_SET_OBJECT_CAPACITY(v, capacity);
+        memcpy(v->u.o.m, m, LEPT_OBJECT_SIZE(v) * sizeof(lept_member));
+        memcpy(LEPT_OBJECT_INDEX(v), m + capacity, extra);
+        for (i = 0; i < LEPT_OBJECT_SIZE(v); i++) {
+            if (!(v->flags & LEPT_BORROWED_KEYS))
+                LEPT_REFCOUNT(v->u.o.m[i].k)++;
+            lept_retain(&v->u.o.m[i].v);
+        }
+        LEPT_REFCOUNT(m)--;
+    }
+}
+
+void lept_share(lept_value* dst, const lept_value* src) {
+    lept_value temp;
+    assert(src != NULL && dst != NULL && src != dst);
+    memcpy(&temp, src, sizeof(lept_value));
+    lept_retain(&temp);
+    /* src may be part of dst */
+    lept_move(dst, &temp);
+}
+
 void lept_move(lept_value* dst, lept_value* src) {
     assert(dst != NULL && src != NULL && src != dst);
     lept_free(dst);
@@ -451,28 +3263,62 @@ void lept_swap(lept_value* lhs, lept_value* rhs) {
     }
 }
 
+typedef struct {
+    lept_value* v;  /* container being freed */
+    size_t i;       /* next element or member */
+}lept_free_frame;
+
 void lept_free(lept_value* v) {
-    size_t i;
+    lept_context c;
+    lept_free_frame* f;
     assert(v != NULL);
-    switch (v->type) {
-        case LEPT_STRING:
-            free(v->u.s.s);
-            break;
-        case LEPT_ARRAY:
-            for (i = 0; i < v->u.a.size; i++)
-                lept_free(&v->u.a.e[i]);
-            free(v->u.a.e);
-            break;
-        case LEPT_OBJECT:
-            for (i = 0; i < v->u.o.size; i++) {
-                free(v->u.o.m[i].k);
-                lept_free(&v->u.o.m[i].v);
+    c.stack = NULL;
+    c.size = c.top = 0;
+    /* depth-first with an explicit stack, so nesting depth costs heap rather than call stack */
+    for (;;) {
+        int open = 0;
+        switch (v->type) {
+            case LEPT_STRING:
+                if (!(v->flags & (LEPT_BORROWED_DATA | LEPT_SHORT_STRING)) && lept_block_release(v->u.s.s))
+                    lept_block_free(v->u.s.s);
+                break;
+            case LEPT_ARRAY:
+                open = !(v->flags & LEPT_LAZY) && ((v->flags & LEPT_BORROWED_DATA) || lept_block_release(v->u.a.e));
+                break;
+            case LEPT_OBJECT:
+                open = !(v->flags & LEPT_LAZY) && ((v->flags & LEPT_BORROWED_DATA) || lept_block_release(v->u.o.m)); /* else still shared */
+                break;
+            default: break;
+        }
+        if (open) {
+            f = (lept_free_frame*)lept_context_push(&c, sizeof(lept_free_frame));
+            f->v = v;
+            f->i = 0;
+        }
+        else
+            v->type = LEPT_NULL;
+        /* continue with the next value of the innermost open container */
+        for (v = NULL; c.top > 0 && v == NULL; ) {
+            f = (lept_free_frame*)(c.stack + c.top - sizeof(lept_free_frame));
+            if (f->v->type == LEPT_ARRAY && f->i < LEPT_ARRAY_SIZE(f->v))
+                v = &f->v->u.a.e[f->i++];
+            else if (f->v->type == LEPT_OBJECT && f->i < LEPT_OBJECT_SIZE(f->v)) {
+                lept_member* m = &f->v->u.o.m[f->i++];
+                if (!(f->v->flags & LEPT_BORROWED_KEYS) && lept_block_release(m->k))
+                    lept_block_free(m->k);
+                v = &m->v;
+            }
+            else {
+                if (!(f->v->flags & LEPT_BORROWED_DATA))
+                    lept_block_free(f->v->type == LEPT_ARRAY ? (void*)f->v->u.a.e : (void*)f->v->u.o.m);
+                f->v->type = LEPT_NULL;
+                lept_context_pop(&c, sizeof(lept_free_frame));
             }
-            free(v->u.o.m);
+        }
+        if (v == NULL)
             break;
-        default: break;
     }
-    v->type = LEPT_NULL;
+    free(c.stack);
 }
 
 lept_type lept_get_type(const lept_value* v) {
@@ -480,30 +3326,197 @@ lept_type lept_get_type(const lept_value* v) {
     return v->type;
 }
 
+typedef struct {
+    const lept_value* lhs, *rhs;    /* containers being compared */
+    size_t i;                       /* next element or member */
+    size_t* map;                    /* rhs member matching each lhs member, NULL when in the same order */
+}lept_equal_frame;
+
+#define LEPT_MATCHED ((size_t)-1)
+
+/* Pairs every member of lhs with a distinct member of rhs that has the same key through a
+   hash table of the rhs keys. Returns NULL when some key has no match. */
+static size_t* lept_match_members(const lept_value* lhs, const lept_value* rhs) {
+    size_t n = LEPT_OBJECT_SIZE(lhs), mask = lept_object_index_size(n) - 1, i, j;
+    size_t* map = (size_t*)malloc(n * sizeof(size_t));
+    size_t* table = (size_t*)calloc(mask + 1, sizeof(size_t)); /* rhs member index + 1, 0 for empty */
+    for (j = 0; j < n; j++) {
+        for (i = lept_hash_key(rhs->u.o.m[j].k, rhs->u.o.m[j].klen) & mask; table[i]; i = (i + 1) & mask)
+            ;
+        table[i] = j + 1;
+    }
+    for (j = 0; j < n && map; j++) {
+        const lept_member* m = &lhs->u.o.m[j];
+        for (i = lept_hash_key(m->k, m->klen) & mask; table[i]; i = (i + 1) & mask) {
+            const lept_member* r = &rhs->u.o.m[table[i] - 1];
+            if (table[i] != LEPT_MATCHED && r->klen == m->klen && memcmp(r->k, m->k, m->klen) == 0) {
+                map[j] = table[i] - 1;
+                table[i] = LEPT_MATCHED; /* keeps probe sequences intact, for duplicate keys */
+                break;
+            }
+        }
+        if (!table[i]) {
+            free(map);
+            map = NULL;
+        }
+    }
+    free(table);
+    return map;
+}
+
 int lept_is_equal(const lept_value* lhs, const lept_value* rhs) {
+    lept_context c;
+    lept_equal_frame* f;
     size_t i;
+    int equal = 1;
     assert(lhs != NULL && rhs != NULL);
-    if (lhs->type != rhs->type)
-        return 0;
-    switch (lhs->type) {
-        case LEPT_STRING:
-            return lhs->u.s.len == rhs->u.s.len && 
-                memcmp(lhs->u.s.s, rhs->u.s.s, lhs->u.s.len) == 0;
-        case LEPT_NUMBER:
-            return lhs->u.n == rhs->u.n;
-        case LEPT_ARRAY:
-            if (lhs->u.a.size != rhs->u.a.size)
-                return 0;
-            for (i = 0; i < lhs->u.a.size; i++)
-                if (!lept_is_equal(&lhs->u.a.e[i], &rhs->u.a.e[i]))
-                    return 0;
-            return 1;
-        case LEPT_OBJECT:
-            /* \todo */
-            return 1;
-        default:
-            return 1;
+    c.stack = NULL;
+    c.size = c.top = 0;
+    for (;;) {
+        /* compare lhs and rhs themselves, their elements or members later */
+        if (lhs->type != rhs->type)
+            equal = 0;
+        else switch (lhs->type) {
+            case LEPT_STRING:
+                equal = LEPT_STRING_LENGTH(lhs) == LEPT_STRING_LENGTH(rhs) &&
+                    memcmp(LEPT_STRING_DATA(lhs), LEPT_STRING_DATA(rhs), LEPT_STRING_LENGTH(lhs)) == 0;
+                break;
+            case LEPT_NUMBER:
+                equal = lhs->u.n == rhs->u.n;
+                break;
+            case LEPT_ARRAY:
+                lept_load(lhs);
+                lept_load(rhs);
+                if (LEPT_ARRAY_SIZE(lhs) != LEPT_ARRAY_SIZE(rhs))
+                    equal = 0;
+                else if (lhs->u.a.e != rhs->u.a.e) { /* else shared */
+                    f = (lept_equal_frame*)lept_context_push(&c, sizeof(lept_equal_frame));
+                    f->lhs = lhs;
+                    f->rhs = rhs;
+                    f->i = 0;
+                    f->map = NULL;
+                }
+                break;
+            case LEPT_OBJECT:
+                lept_load(lhs);
+                lept_load(rhs);
+                if (LEPT_OBJECT_SIZE(lhs) != LEPT_OBJECT_SIZE(rhs))
+                    equal = 0;
+                else if (lhs->u.o.m != rhs->u.o.m) {
+                    size_t* map = NULL;
+                    /* members usually come in the same order, only match keys when they do not */
+                    for (i = 0; i < LEPT_OBJECT_SIZE(lhs); i++)
+                        if (lhs->u.o.m[i].klen != rhs->u.o.m[i].klen || memcmp(lhs->u.o.m[i].k, rhs->u.o.m[i].k, lhs->u.o.m[i].klen) != 0)
+                            break;
+                    if (i < LEPT_OBJECT_SIZE(lhs) && !(map = lept_match_members(lhs, rhs))) {
+                        equal = 0;
+                        break;
+                    }
+                    f = (lept_equal_frame*)lept_context_push(&c, sizeof(lept_equal_frame));
+                    f->lhs = lhs;
+                    f->rhs = rhs;
+                    f->i = 0;
+                    f->map = map;
+                }
+                break;
+            default:
+                break;
+        }
+        if (!equal)
+            break;
+        /* continue with the next pair of elements or member values */
+        for (lhs = NULL; c.top > 0 && lhs == NULL; ) {
+            f = (lept_equal_frame*)(c.stack + c.top - sizeof(lept_equal_frame));
+            if (f->lhs->type == LEPT_ARRAY && f->i < LEPT_ARRAY_SIZE(f->lhs)) {
+                lhs = &f->lhs->u.a.e[f->i];
+                rhs = &f->rhs->u.a.e[f->i++];
+            }
+            else if (f->lhs->type == LEPT_OBJECT && f->i < LEPT_OBJECT_SIZE(f->lhs)) {
+                lhs = &f->lhs->u.o.m[f->i].v;
+                rhs = &f->rhs->u.o.m[f->map ? f->map[f->i] : f->i].v;
+                f->i++;
+            }
+            else {
+                free(f->map);
+                lept_context_pop(&c, sizeof(lept_equal_frame));
+            }
+        }
+        if (lhs == NULL)
+            break;
+    }
+    while (c.top > 0)
+        free(((lept_equal_frame*)lept_context_pop(&c, sizeof(lept_equal_frame)))->map);
+    free(c.stack);
+    return equal;
+}
+
+typedef struct {
+    const lept_value* v;    /* container being hashed */
+    size_t i;               /* next element or member */
+    size_t h;               /* hash so far */
+}lept_hash_frame;
+
+#define LEPT_HASH_COMBINE(h, x) ((h) ^ ((x) + 0x9E3779B9u + ((h) << 6) + ((h) >> 2)))
+
+size_t lept_hash(const lept_value* v) {
+    lept_context c;
+    lept_hash_frame* f;
+    size_t h;
+    double n;
+    assert(v != NULL);
+    c.stack = NULL;
+    c.size = c.top = 0;
+    for (;;) {
+        h = v->type;
+        switch (v->type) {
+            case LEPT_NUMBER:
+                n = v->u.n == 0.0 ? 0.0 : v->u.n; /* -0 == 0 */
+                h = LEPT_HASH_COMBINE(h, lept_hash_key((const char*)&n, sizeof(n)));
+                break;
+            case LEPT_STRING:
+                h = LEPT_HASH_COMBINE(h, lept_hash_key(LEPT_STRING_DATA(v), LEPT_STRING_LENGTH(v)));
+                break;
+            case LEPT_ARRAY:
+            case LEPT_OBJECT:
+                lept_load(v);
+                h = LEPT_HASH_COMBINE(h, v->type == LEPT_ARRAY ? LEPT_ARRAY_SIZE(v) : LEPT_OBJECT_SIZE(v));
+                if (v->type == LEPT_ARRAY ? LEPT_ARRAY_SIZE(v) > 0 : LEPT_OBJECT_SIZE(v) > 0) {
+                    f = (lept_hash_frame*)lept_context_push(&c, sizeof(lept_hash_frame));
+                    f->v = v;
+                    f->i = 0;
+                    f->h = h;
+                    v = v->type == LEPT_ARRAY ? &v->u.a.e[0] : &v->u.o.m[0].v;
+                    continue;
+                }
+                break;
+            default:
+                break;
+        }
+        /* fold h into its container: in order for arrays, in any order for objects */
+        for (v = NULL; c.top > 0 && v == NULL; ) {
+            f = (lept_hash_frame*)(c.stack + c.top - sizeof(lept_hash_frame));
+            if (f->v->type == LEPT_ARRAY) {
+                f->h = LEPT_HASH_COMBINE(f->h, h);
+                if (++f->i < LEPT_ARRAY_SIZE(f->v))
+                    v = &f->v->u.a.e[f->i];
+            }
+            else {
+                const lept_member* m = &f->v->u.o.m[f->i];
+                size_t k = lept_hash_key(m->k, m->klen);
+                f->h += LEPT_HASH_COMBINE(k, h);
+                if (++f->i < LEPT_OBJECT_SIZE(f->v))
+                    v = &f->v->u.o.m[f->i].v;
+            }
+            if (v == NULL) {
+                h = f->h;
+                lept_context_pop(&c, sizeof(lept_hash_frame));
+            }
+        }
+        if (v == NULL)
+            break;
     }
+    free(c.stack);
+    return h;
 }
 
 int lept_get_boolean(const lept_value* v) {
@@ -529,151 +3542,279 @@ void lept_set_number(lept_value* v, double n) {
 
 const char* lept_get_string(const lept_value* v) {
     assert(v != NULL && v->type == LEPT_STRING);
-    return v->u.s.s;
+    return LEPT_STRING_DATA(v);
 }
 
 size_t lept_get_string_length(const lept_value* v) {
     assert(v != NULL && v->type == LEPT_STRING);
-    return v->u.s.len;
+    return LEPT_STRING_LENGTH(v);
 }
 
 void lept_set_string(lept_value* v, const char* s, size_t len) {
     assert(v != NULL && (s != NULL || len == 0));
     lept_free(v);
-    v->u.s.s = (char*)malloc(len + 1);
-    memcpy(v->u.s.s, s, len);
-    v->u.s.s[len] = '\0';
-    v->u.s.len = len;
+    if (len <= LEPT_SHORT_STRING_MAX) {
+        lept_set_short_string(v, s, len);
+        return;
+    }
+    v->u.s.s = lept_strdup(s, len);
+    LEPT_LONG_STRING_LENGTH(v) = len;
     v->type = LEPT_STRING;
+    v->flags = 0;
 }
 
 void lept_set_array(lept_value* v, size_t capacity) {
     assert(v != NULL);
     lept_free(v);
     v->type = LEPT_ARRAY;
-    v->u.a.size = 0;
-    v->u.a.capacity = capacity;
-    v->u.a.e = capacity > 0 ? (lept_value*)malloc(capacity * sizeof(lept_value)) : NULL;
+    v->flags = 0;
+    LEPT_ARRAY_SIZE(v) = 0;
+    v->u.a.e = capacity > 0 ? (lept_value*)lept_block_alloc(capacity * sizeof(lept_value)) : NULL;
+    LEPT_SET_ARRAY_CAPACITY(v, capacity);
 }
 
 size_t lept_get_array_size(const lept_value* v) {
     assert(v != NULL && v->type == LEPT_ARRAY);
-    return v->u.a.size;
+    lept_load(v);
+    return LEPT_ARRAY_SIZE(v);
 }
 
 size_t lept_get_array_capacity(const lept_value* v) {
     assert(v != NULL && v->type == LEPT_ARRAY);
-    return v->u.a.capacity;
+    lept_load(v);
+    return LEPT_ARRAY_CAPACITY(v);
+}
+
+static void* lept_realloc_data(lept_value* v, void* p, size_t old_size, size_t new_size) {
+    void* ret;
+    if (!(v->flags & LEPT_BORROWED_DATA))
+        return lept_block_realloc(p, new_size);
+    /* an arena block cannot be resized, move it to the heap */
+    ret = lept_block_alloc(new_size);
+    memcpy(ret, p, old_size < new_size ? old_size : new_size);
+    v->flags &= ~LEPT_BORROWED_DATA;
+    return ret;
 }
 
 void lept_reserve_array(lept_value* v, size_t capacity) {
     assert(v != NULL && v->type == LEPT_ARRAY);
-    if (v->u.a.capacity < capacity) {
-        v->u.a.capacity = capacity;
-        v->u.a.e = (lept_value*)realloc(v->u.a.e, capacity * sizeof(lept_value));
+    lept_load(v);
+    lept_unshare(v);
+    if (LEPT_ARRAY_CAPACITY(v) < capacity) {
+        v->u.a.e = (lept_value*)lept_realloc_data(v, v->u.a.e, LEPT_ARRAY_SIZE(v) * sizeof(lept_value), capacity * sizeof(lept_value));
+        LEPT_SET_ARRAY_CAPACITY(v, capacity);
     }
 }
 
 void lept_shrink_array(lept_value* v) {
     assert(v != NULL && v->type == LEPT_ARRAY);
-    if (v->u.a.capacity > v->u.a.size) {
-        v->u.a.capacity = v->u.a.size;
-        v->u.a.e = (lept_value*)realloc(v->u.a.e, v->u.a.capacity * sizeof(lept_value));
+    lept_load(v);
+    lept_unshare(v);
+    if (LEPT_ARRAY_CAPACITY(v) > LEPT_ARRAY_SIZE(v)) {
+        v->u.a.e = (lept_value*)lept_realloc_data(v, v->u.a.e, LEPT_ARRAY_SIZE(v) * sizeof(lept_value), LEPT_ARRAY_SIZE(v) * sizeof(lept_value));
+        LEPT_SET_ARRAY_CAPACITY(v, LEPT_ARRAY_SIZE(v));
     }
 }
 
 void lept_clear_array(lept_value* v) {
     assert(v != NULL && v->type == LEPT_ARRAY);
-    lept_erase_array_element(v, 0, v->u.a.size);
+    lept_load(v);
+    if (!(v->flags & LEPT_BORROWED_DATA) && v->u.a.e != NULL && LEPT_REFCOUNT(v->u.a.e) > 1) {
+        /* no point in unsharing elements only to free them */
+        size_t capacity = LEPT_ARRAY_CAPACITY(v);
+        LEPT_REFCOUNT(v->u.a.e)--;
+        v->u.a.e = (lept_value*)lept_block_alloc(capacity * sizeof(lept_value));
+        LEPT_SET_ARRAY_CAPACITY(v, capacity);
+        LEPT_ARRAY_SIZE(v) = 0;
+        return;
+    }
+    lept_erase_array_element(v, 0, LEPT_ARRAY_SIZE(v)); /* keeps the capacity for reuse */
 }
 
 lept_value* lept_get_array_element(lept_value* v, size_t index) {
     assert(v != NULL && v->type == LEPT_ARRAY);
-    assert(index < v->u.a.size);
+    lept_load(v);
+    assert(index < LEPT_ARRAY_SIZE(v));
+    lept_unshare(v);
     return &v->u.a.e[index];
 }
 
 lept_value* lept_pushback_array_element(lept_value* v) {
     assert(v != NULL && v->type == LEPT_ARRAY);
-    if (v->u.a.size == v->u.a.capacity)
-        lept_reserve_array(v, v->u.a.capacity == 0 ? 1 : v->u.a.capacity * 2);
-    lept_init(&v->u.a.e[v->u.a.size]);
-    return &v->u.a.e[v->u.a.size++];
+    lept_load(v);
+    lept_unshare(v);
+    if (LEPT_ARRAY_SIZE(v) == LEPT_ARRAY_CAPACITY(v))
+        lept_reserve_array(v, LEPT_ARRAY_CAPACITY(v) == 0 ? 1 : LEPT_ARRAY_CAPACITY(v) * 2);
+    lept_init(&v->u.a.e[LEPT_ARRAY_SIZE(v)]);
+    return &v->u.a.e[LEPT_ARRAY_SIZE(v)++];
 }
 
 void lept_popback_array_element(lept_value* v) {
-    assert(v != NULL && v->type == LEPT_ARRAY && v->u.a.size > 0);
-    lept_free(&v->u.a.e[--v->u.a.size]);
+    assert(v != NULL && v->type == LEPT_ARRAY);
+    lept_load(v);
+    assert(LEPT_ARRAY_SIZE(v) > 0);
+    lept_unshare(v);
+    lept_free(&v->u.a.e[--LEPT_ARRAY_SIZE(v)]);
 }
 
 lept_value* lept_insert_array_element(lept_value* v, size_t index) {
-    assert(v != NULL && v->type == LEPT_ARRAY && index <= v->u.a.size);
-    /* \todo */
-    return NULL;
+    return lept_insert_array_elements(v, index, 1);
+}
+
+lept_value* lept_insert_array_elements(lept_value* v, size_t index, size_t count) {
+    size_t i;
+    assert(v != NULL && v->type == LEPT_ARRAY);
+    lept_load(v);
+    assert(index <= LEPT_ARRAY_SIZE(v));
+    lept_unshare(v);
+    if (LEPT_ARRAY_SIZE(v) + count > LEPT_ARRAY_CAPACITY(v))
+        lept_reserve_array(v, LEPT_ARRAY_SIZE(v) + count > LEPT_ARRAY_CAPACITY(v) * 2 ? LEPT_ARRAY_SIZE(v) + count : LEPT_ARRAY_CAPACITY(v) * 2);
+    memmove(&v->u.a.e[index + count], &v->u.a.e[index], (LEPT_ARRAY_SIZE(v) - index) * sizeof(lept_value));
+    for (i = index; i < index + count; i++)
+        lept_init(&v->u.a.e[i]);
+    LEPT_ARRAY_SIZE(v) += count;
+    return &v->u.a.e[index];
 }
 
 void lept_erase_array_element(lept_value* v, size_t index, size_t count) {
-    assert(v != NULL && v->type == LEPT_ARRAY && index + count <= v->u.a.size);
-    /* \todo */
+    size_t i;
+    assert(v != NULL && v->type == LEPT_ARRAY);
+    lept_load(v);
+    assert(index + count <= LEPT_ARRAY_SIZE(v));
+    if (count == 0)
+        return;
+    lept_unshare(v);
+    for (i = index; i < index + count; i++)
+        lept_free(&v->u.a.e[i]);
+    memmove(&v->u.a.e[index], &v->u.a.e[index + count], (LEPT_ARRAY_SIZE(v) - index - count) * sizeof(lept_value));
+    LEPT_ARRAY_SIZE(v) -= count;
 }
 
 void lept_set_object(lept_value* v, size_t capacity) {
     assert(v != NULL);
     lept_free(v);
     v->type = LEPT_OBJECT;
-    v->u.o.size = 0;
-    v->u.o.capacity = capacity;
-    v->u.o.m = capacity > 0 ? (lept_member*)malloc(capacity * sizeof(lept_member)) : NULL;
+    v->flags = 0;
+    LEPT_OBJECT_SIZE(v) = 0;
+    v->u.o.m = capacity > 0 ? (lept_member*)lept_block_alloc(capacity * sizeof(lept_member)) : NULL;
+    LEPT_SET_OBJECT_CAPACITY(v, capacity);
 }
 
 size_t lept_get_object_size(const lept_value* v) {
     assert(v != NULL && v->type == LEPT_OBJECT);
-    return v->u.o.size;
+    lept_load(v);
+    return LEPT_OBJECT_SIZE(v);
 }
 
 size_t lept_get_object_capacity(const lept_value* v) {
     assert(v != NULL && v->type == LEPT_OBJECT);
-    /* \todo */
-    return 0;
+    lept_load(v);
+    return LEPT_OBJECT_CAPACITY(v);
+}
+
+/* Reallocates the members of an unshared object, with a rebuilt index behind them if it had one. */
+static void lept_resize_object(lept_value* v, size_t capacity) {
+    size_t extra;
+    if (capacity < LEPT_OBJECT_INDEX_MIN_SIZE)
+        v->flags &= ~LEPT_OBJECT_INDEXED;
+    extra = v->flags & LEPT_OBJECT_INDEXED ? lept_object_index_size(capacity) * sizeof(size_t) : 0;
+    v->u.o.m = (lept_member*)lept_realloc_data(v, v->u.o.m, LEPT_OBJECT_SIZE(v) * sizeof(lept_member), capacity * sizeof(lept_member) + extra);
+    LEPT_SET_OBJECT_CAPACITY(v, capacity);
+    if (v->flags & LEPT_OBJECT_INDEXED)
+        lept_object_index_fill(v);
 }
 
 void lept_reserve_object(lept_value* v, size_t capacity) {
     assert(v != NULL && v->type == LEPT_OBJECT);
-    /* \todo */
+    lept_load(v);
+    lept_unshare(v);
+    if (LEPT_OBJECT_CAPACITY(v) < capacity)
+        lept_resize_object(v, capacity);
 }
 
 void lept_shrink_object(lept_value* v) {
     assert(v != NULL && v->type == LEPT_OBJECT);
-    /* \todo */
+    lept_load(v);
+    lept_unshare(v);
+    if (LEPT_OBJECT_CAPACITY(v) > LEPT_OBJECT_SIZE(v))
+        lept_resize_object(v, LEPT_OBJECT_SIZE(v));
+}
+
+static void lept_free_member(lept_value* v, lept_member* m) {
+    if (!(v->flags & LEPT_BORROWED_KEYS) && lept_block_release(m->k))
+        lept_block_free(m->k);
+    lept_free(&m->v);
 }
 
 void lept_clear_object(lept_value* v) {
+    size_t i;
     assert(v != NULL && v->type == LEPT_OBJECT);
-    /* \todo */
+    lept_load(v);
+    if (!(v->flags & LEPT_BORROWED_DATA) && v->u.o.m != NULL && LEPT_REFCOUNT(v->u.o.m) > 1) {
+        /* no point in unsharing members only to free them */
+        size_t capacity = LEPT_OBJECT_CAPACITY(v);
+        size_t extra = v->flags & LEPT_OBJECT_INDEXED ? lept_object_index_size(capacity) * sizeof(size_t) : 0;
+        LEPT_REFCOUNT(v->u.o.m)--;
+        v->u.o.m = (lept_member*)lept_block_alloc(capacity * sizeof(lept_member) + extra);
+        LEPT_SET_OBJECT_CAPACITY(v, capacity);
+    }
+    else
+        for (i = 0; i < LEPT_OBJECT_SIZE(v); i++)
+            lept_free_member(v, &v->u.o.m[i]);
+    LEPT_OBJECT_SIZE(v) = 0;
+    v->flags &= ~LEPT_BORROWED_KEYS; /* keys added from now on are owned anyway */
+    if (v->flags & LEPT_OBJECT_INDEXED)
+        lept_object_index_fill(v);
 }
 
 const char* lept_get_object_key(const lept_value* v, size_t index) {
     assert(v != NULL && v->type == LEPT_OBJECT);
-    assert(index < v->u.o.size);
+    lept_load(v);
+    assert(index < LEPT_OBJECT_SIZE(v));
     return v->u.o.m[index].k;
 }
 
 size_t lept_get_object_key_length(const lept_value* v, size_t index) {
     assert(v != NULL && v->type == LEPT_OBJECT);
-    assert(index < v->u.o.size);
+    lept_load(v);
+    assert(index < LEPT_OBJECT_SIZE(v));
     return v->u.o.m[index].klen;
 }
 
 lept_value* lept_get_object_value(lept_value* v, size_t index) {
     assert(v != NULL && v->type == LEPT_OBJECT);
-    assert(index < v->u.o.size);
+    lept_load(v);
+    assert(index < LEPT_OBJECT_SIZE(v));
+    lept_unshare(v);
     return &v->u.o.m[index].v;
 }
 
+static void lept_build_object_index(lept_value* v) {
+    size_t n = lept_object_index_size(LEPT_OBJECT_CAPACITY(v));
+    assert(!(v->flags & (LEPT_BORROWED_DATA | LEPT_OBJECT_INDEXED)));
+    v->u.o.m = (lept_member*)lept_block_realloc(v->u.o.m, LEPT_OBJECT_CAPACITY(v) * sizeof(lept_member) + n * sizeof(size_t));
+    lept_object_index_fill(v);
+}
+
 size_t lept_find_object_index(const lept_value* v, const char* key, size_t klen) {
     size_t i;
     assert(v != NULL && v->type == LEPT_OBJECT && key != NULL);
-    for (i = 0; i < v->u.o.size; i++)
+    lept_load(v);
+    /* the index is a cache, so a lookup may build it, though not in storage shared with others */
+    if (!(v->flags & (LEPT_OBJECT_INDEXED | LEPT_BORROWED_DATA)) && LEPT_OBJECT_SIZE(v) >= LEPT_OBJECT_INDEX_MIN_SIZE &&
+        LEPT_REFCOUNT(v->u.o.m) == 1)
+        lept_build_object_index((lept_value*)v);
+    if (v->flags & LEPT_OBJECT_INDEXED) {
+        size_t mask = lept_object_index_size(LEPT_OBJECT_CAPACITY(v)) - 1;
+        const size_t* index = LEPT_OBJECT_INDEX(v);
+        for (i = lept_hash_key(key, klen) & mask; index[i]; i = (i + 1) & mask) {
+            const lept_member* m = &v->u.o.m[index[i] - 1];
+            if (m->klen == klen && memcmp(m->k, key, klen) == 0)
+                return index[i] - 1;
+        }
+        return LEPT_KEY_NOT_EXIST;
+    }
+    for (i = 0; i < LEPT_OBJECT_SIZE(v); i++)
         if (v->u.o.m[i].klen == klen && memcmp(v->u.o.m[i].k, key, klen) == 0)
             return i;
     return LEPT_KEY_NOT_EXIST;
@@ -681,16 +3822,555 @@ size_t lept_find_object_index(const lept_value* v, const char* key, size_t klen)
 
 lept_value* lept_find_object_value(lept_value* v, const char* key, size_t klen) {
     size_t index = lept_find_object_index(v, key, klen);
-    return index != LEPT_KEY_NOT_EXIST ? &v->u.o.m[index].v : NULL;
+    if (index == LEPT_KEY_NOT_EXIST)
+        return NULL;
+    lept_unshare(v);
+    return &v->u.o.m[index].v;
 }
 
 lept_value* lept_set_object_value(lept_value* v, const char* key, size_t klen) {
+    size_t i;
+    lept_member* m;
     assert(v != NULL && v->type == LEPT_OBJECT && key != NULL);
-    /* \todo */
-    return NULL;
+    lept_load(v);
+    lept_unshare(v);
+    if ((i = lept_find_object_index(v, key, klen)) != LEPT_KEY_NOT_EXIST)
+        return &v->u.o.m[i].v;
+    if (LEPT_OBJECT_SIZE(v) == LEPT_OBJECT_CAPACITY(v))
+        lept_resize_object(v, LEPT_OBJECT_CAPACITY(v) == 0 ? 1 : LEPT_OBJECT_CAPACITY(v) * 2);
+    if (v->flags & LEPT_BORROWED_KEYS) {
+        /* the new key is owned, so all of them have to be */
+        for (i = 0; i < LEPT_OBJECT_SIZE(v); i++)
+            v->u.o.m[i].k = lept_strdup(v->u.o.m[i].k, v->u.o.m[i].klen);
+        v->flags &= ~LEPT_BORROWED_KEYS;
+    }
+    m = &v->u.o.m[LEPT_OBJECT_SIZE(v)];
+    m->k = lept_strdup(key, klen);
+    m->klen = klen;
+    lept_init(&m->v);
+    if (v->flags & LEPT_OBJECT_INDEXED)
+        lept_object_index_add(v, LEPT_OBJECT_SIZE(v));
+    LEPT_OBJECT_SIZE(v)++;
+    return &m->v;
+}
+
+void lept_set_object_values(lept_value* v, lept_member* members, size_t count) {
+    size_t i;
+    assert(v != NULL && v->type == LEPT_OBJECT && (members != NULL || count == 0));
+    lept_load(v);
+    lept_unshare(v);
+    if (LEPT_OBJECT_SIZE(v) + count > LEPT_OBJECT_CAPACITY(v))
+        lept_resize_object(v, LEPT_OBJECT_SIZE(v) + count > LEPT_OBJECT_CAPACITY(v) * 2 ? LEPT_OBJECT_SIZE(v) + count : LEPT_OBJECT_CAPACITY(v) * 2);
+    for (i = 0; i < count; i++)
+        lept_move(lept_set_object_value(v, members[i].k, members[i].klen), &members[i].v);
 }
 
 void lept_remove_object_value(lept_value* v, size_t index) {
-    assert(v != NULL && v->type == LEPT_OBJECT && index < v->u.o.size);
-    /* \todo */
+    assert(v != NULL && v->type == LEPT_OBJECT);
+    lept_load(v);
+    assert(index < LEPT_OBJECT_SIZE(v));
+    lept_unshare(v);
+    lept_free_member(v, &v->u.o.m[index]);
+    memmove(&v->u.o.m[index], &v->u.o.m[index + 1], (LEPT_OBJECT_SIZE(v) - index - 1) * sizeof(lept_member));
+    LEPT_OBJECT_SIZE(v)--;
+    /* every later member moved, so the index is rebuilt */
+    if (v->flags & LEPT_OBJECT_INDEXED)
+        lept_object_index_fill(v);
+}
+
+void lept_swap_remove_object_value(lept_value* v, size_t index) {
+    size_t last;
+    assert(v != NULL && v->type == LEPT_OBJECT);
+    lept_load(v);
+    assert(index < LEPT_OBJECT_SIZE(v));
+    lept_unshare(v);
+    if (v->flags & LEPT_OBJECT_INDEXED)
+        lept_object_index_remove(v, index);
+    lept_free_member(v, &v->u.o.m[index]);
+    last = --LEPT_OBJECT_SIZE(v);
+    if (index != last) {
+        if (v->flags & LEPT_OBJECT_INDEXED)
+            *lept_object_index_slot(v, last) = index + 1;
+        memcpy(&v->u.o.m[index], &v->u.o.m[last], sizeof(lept_member));
+    }
+}
+
+/* JSON Pointers (RFC 6901) are "" for the whole document, or reference tokens each after a
+   '/', with "~0" for '~' and "~1" for '/'. Tokens of arrays are indices without leading zeros. */
+
+static int lept_pointer_valid(const char* ptr) {
+    if (*ptr != '\0' && *ptr != '/')
+        return 0;
+    for (; *ptr != '\0'; ptr++)
+        if (*ptr == '~' && ptr[1] != '0' && ptr[1] != '1')
+            return 0;
+    return 1;
+}
+
+static int lept_pointer_index(const char* token, size_t tlen, size_t* index) {
+    size_t i;
+    if (tlen == 0 || (tlen > 1 && token[0] == '0'))
+        return 0;
+    for (*index = 0, i = 0; i < tlen; i++) {
+        if (!ISDIGIT(token[i]) || *index > ((size_t)-1 - 9) / 10)
+            return 0;
+        *index = *index * 10 + (token[i] - '0');
+    }
+    return 1;
+}
+
+static int lept_pointer_token_is(const char* token, size_t tlen, const char* key, size_t klen) {
+    const char* end = token + tlen;
+    for (; token != end; token++, key++, klen--) {
+        char ch = *token;
+        if (ch == '~')
+            ch = *++token == '0' ? '~' : '/';
+        if (klen == 0 || *key != ch)
+            return 0;
+    }
+    return klen == 0;
+}
+
+const lept_value* lept_pointer_get(const lept_value* v, const char* ptr) {
+    assert(v != NULL && ptr != NULL);
+    if (!lept_pointer_valid(ptr))
+        return NULL;
+    while (v != NULL && *ptr == '/') {
+        const char* token = ++ptr;
+        size_t tlen = strcspn(token, "/"), i;
+        ptr += tlen;
+        if (v->type == LEPT_OBJECT) {
+            lept_load(v);
+            if (memchr(token, '~', tlen) == NULL)
+                i = lept_find_object_index(v, token, tlen);
+            else
+                for (i = 0; i < LEPT_OBJECT_SIZE(v) && !lept_pointer_token_is(token, tlen, v->u.o.m[i].k, v->u.o.m[i].klen); i++)
+                    ;
+            v = i < LEPT_OBJECT_SIZE(v) ? &v->u.o.m[i].v : NULL;
+        }
+        else if (v->type == LEPT_ARRAY) {
+            lept_load(v);
+            v = lept_pointer_index(token, tlen, &i) && i < LEPT_ARRAY_SIZE(v) ? &v->u.a.e[i] : NULL;
+        }
+        else
+            v = NULL;
+    }
+    return v;
+}
+
+/* Skips the value at c->json, only checking that its brackets balance and strings end. */
+static int lept_pointer_skip(lept_context* c) {
+    const char* p = c->json;
+    size_t depth = 0;
+    if (p == c->end)
+        return LEPT_PARSE_EXPECT_VALUE;
+    do {
+        if (p == c->end)
+            return *c->json == '[' ? LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET : LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET;
+        switch (*p++) {
+            case '[':
+            case '{':
+                depth++;
+                break;
+            case ']':
+            case '}':
+                if (depth-- == 0)
+                    return LEPT_PARSE_INVALID_VALUE;
+                break;
+            case '\"':
+                for (;;) {
+                    if ((p = lept_scan_string(p, c->end)) == c->end)
+                        return LEPT_PARSE_MISS_QUOTATION_MARK;
+                    if (*p == '\"')
+                        break;
+                    if (*p != '\\')
+                        return LEPT_PARSE_INVALID_STRING_CHAR;
+                    if (c->end - p < 2)
+                        return LEPT_PARSE_MISS_QUOTATION_MARK;
+                    p += 2;
+                }
+                p++;
+                break;
+            default:
+                if (depth == 0) /* a scalar */
+                    while (p != c->end && *p != ',' && *p != ']' && *p != '}' && !ISWHITESPACE(*p))
+                        p++;
+                break;
+        }
+    } while (depth > 0);
+    c->json = p;
+    return LEPT_PARSE_OK;
+}
+
+/* Reads the key at c->json, in place unless it has escapes, until the next push on c. */
+static int lept_pointer_key(lept_context* c, const char** key, size_t* klen) {
+    const char* p = c->json + 1;
+    const char* q = lept_scan_string(p, c->end);
+    char* str;
+    int ret;
+    if (q != c->end && *q == '\"') {
+        *key = p;
+        *klen = q - p;
+        c->json = q + 1;
+        return LEPT_PARSE_OK;
+    }
+    if ((ret = lept_parse_string_raw(c, &str, klen)) != LEPT_PARSE_OK)
+        return ret;
+    *key = str;
+    return LEPT_PARSE_OK;
+}
+
+/* Moves c->json to the value of the member named by the token, of the object at c->json. */
+static int lept_pointer_member(lept_context* c, const char* token, size_t tlen) {
+    const char* key;
+    size_t klen;
+    int ret, match;
+    c->json++;
+    lept_parse_whitespace(c);
+    if (PEEK(c) == '}')
+        return LEPT_PARSE_POINTER_NOT_FOUND;
+    for (;;) {
+        if (PEEK(c) != '"')
+            return LEPT_PARSE_MISS_KEY;
+        if ((ret = lept_pointer_key(c, &key, &klen)) != LEPT_PARSE_OK)
+            return ret;
+        match = lept_pointer_token_is(token, tlen, key, klen);
+        lept_parse_whitespace(c);
+        if (PEEK(c) != ':')
+            return LEPT_PARSE_MISS_COLON;
+        c->json++;
+        lept_parse_whitespace(c);
+        if (match)
+            return LEPT_PARSE_OK;
+        if ((ret = lept_pointer_skip(c)) != LEPT_PARSE_OK)
+            return ret;
+        lept_parse_whitespace(c);
+        if (PEEK(c) == ',') {
+            c->json++;
+            lept_parse_whitespace(c);
+        }
+        else if (PEEK(c) == '}')
+            return LEPT_PARSE_POINTER_NOT_FOUND;
+        else
+            return LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET;
+    }
+}
+
+/* Moves c->json to the element at index of the array at c->json. */
+static int lept_pointer_element(lept_context* c, size_t index) {
+    int ret;
+    c->json++;
+    lept_parse_whitespace(c);
+    if (PEEK(c) == ']')
+        return LEPT_PARSE_POINTER_NOT_FOUND;
+    for (; index > 0; index--) {
+        if ((ret = lept_pointer_skip(c)) != LEPT_PARSE_OK)
+            return ret;
+        lept_parse_whitespace(c);
+        if (PEEK(c) == ',') {
+            c->json++;
+            lept_parse_whitespace(c);
+        }
+        else if (PEEK(c) == ']')
+            return LEPT_PARSE_POINTER_NOT_FOUND;
+        else
+            return LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET;
+    }
+    return LEPT_PARSE_OK;
+}
+
+int lept_pointer_extract(const char* json, size_t len, const char* ptr, lept_value* out) {
+    lept_context c;
+    int ret = LEPT_PARSE_OK;
+    assert(out != NULL && ptr != NULL && (json != NULL || len == 0));
+    lept_init(out);
+    if (!lept_pointer_valid(ptr))
+        return LEPT_PARSE_INVALID_POINTER;
+    lept_context_init(&c, json, len);
+    lept_parse_whitespace(&c);
+    while (ret == LEPT_PARSE_OK && *ptr == '/') {
+        const char* token = ++ptr;
+        size_t tlen = strcspn(token, "/"), index;
+        ptr += tlen;
+        if (PEEK(&c) != '{' && PEEK(&c) != '[')
+            ret = c.json == c.end ? LEPT_PARSE_EXPECT_VALUE : LEPT_PARSE_POINTER_NOT_FOUND;
+        else if (++c.depth > c.max_depth)
+            ret = LEPT_PARSE_NESTING_TOO_DEEP;
+        else if (*c.json == '{')
+            ret = lept_pointer_member(&c, token, tlen);
+        else
+            ret = lept_pointer_index(token, tlen, &index) ? lept_pointer_element(&c, index) : LEPT_PARSE_POINTER_NOT_FOUND;
+    }
+    if (ret == LEPT_PARSE_OK) {
+        /* the target, and nothing after it, is parsed as usual */
+        c.handler = &lept_dom_handler;
+        c.user = &c;
+        if ((ret = lept_parse_value(&c)) == LEPT_PARSE_OK)
+            memcpy(out, lept_context_pop(&c, sizeof(lept_value)), sizeof(lept_value));
+        else
+            lept_dom_discard(&c);
+    }
+    free(c.stack);
+    return ret;
+}
+
+/* A pointer set is a trie of reference tokens. Each pointer is parsed where its path ends,
+   unless another one is parsed on the way (or at the same place): it is then looked up in
+   that one's value once the scan is over. */
+
+#define LEPT_POINTER_NONE ((size_t)-1)
+
+typedef struct {
+    const char* token;  /* escaped, in the copy of the pointers */
+    size_t tlen;
+    size_t index;       /* token as an array index, or LEPT_POINTER_NONE */
+    size_t child, next; /* first child and next sibling, 0 for none */
+    size_t target;      /* pointer parsed here, or LEPT_POINTER_NONE */
+}lept_pointer_node;
+
+struct lept_pointer_set {
+    char** ptrs;
+    size_t count;
+    lept_pointer_node* nodes;   /* the root first */
+    size_t node_count;
+    size_t* base;               /* pointer whose value holds pointer i, or LEPT_POINTER_NONE */
+    size_t* suffix;             /* offset of the rest of pointer i within base */
+    size_t scanned;             /* pointers without a base */
+};
+
+static size_t lept_pointer_child(const lept_pointer_node* nodes, size_t n, const char* token, size_t tlen) {
+    size_t child;
+    for (child = nodes[n].child; child != 0; child = nodes[child].next)
+        if (nodes[child].tlen == tlen && memcmp(nodes[child].token, token, tlen) == 0)
+            break;
+    return child;
+}
+
+lept_pointer_set* lept_pointer_set_new(const char* const* ptrs, size_t count) {
+    lept_pointer_set* set;
+    size_t i, n, size = 1;
+    assert(ptrs != NULL || count == 0);
+    for (i = 0; i < count; i++) {
+        const char* p;
+        if (!lept_pointer_valid(ptrs[i]))
+            return NULL;
+        for (p = ptrs[i]; *p != '\0'; p++)
+            size += *p == '/';
+    }
+    set = (lept_pointer_set*)malloc(sizeof(lept_pointer_set));
+    set->ptrs = (char**)malloc((count + 1) * sizeof(char*));
+    set->count = count;
+    set->nodes = (lept_pointer_node*)malloc(size * sizeof(lept_pointer_node));
+    set->base = (size_t*)malloc((count + 1) * sizeof(size_t));
+    set->suffix = (size_t*)malloc((count + 1) * sizeof(size_t));
+    set->scanned = 0;
+    set->nodes[0].child = 0;
+    set->nodes[0].target = LEPT_POINTER_NONE;
+    size = 1;
+    for (i = 0; i < count; i++) {
+        const char* p = set->ptrs[i] = lept_strdup(ptrs[i], strlen(ptrs[i]));
+        for (n = 0; *p == '/'; ) {
+            const char* token = ++p;
+            size_t tlen = strcspn(token, "/"), child;
+            p += tlen;
+            if ((child = lept_pointer_child(set->nodes, n, token, tlen)) == 0) {
+                lept_pointer_node* node = &set->nodes[child = size++];
+                node->token = token;
+                node->tlen = tlen;
+                if (!lept_pointer_index(token, tlen, &node->index))
+                    node->index = LEPT_POINTER_NONE;
+                node->child = 0;
+                node->next = set->nodes[n].child;
+                node->target = LEPT_POINTER_NONE;
+                set->nodes[n].child = child;
+            }
+            n = child;
+        }
+        if (set->nodes[n].target == LEPT_POINTER_NONE)
+            set->nodes[n].target = i;
+    }
+    set->node_count = size;
+    /* find the first value parsed on the way of each pointer */
+    for (i = 0; i < count; i++) {
+        const char* p = set->ptrs[i];
+        for (n = 0; set->nodes[n].target == LEPT_POINTER_NONE; ) {
+            const char* token = ++p;
+            size_t tlen = strcspn(token, "/");
+            p += tlen;
+            n = lept_pointer_child(set->nodes, n, token, tlen);
+        }
+        if (set->nodes[n].target == i) {
+            set->base[i] = LEPT_POINTER_NONE;
+            set->scanned++;
+        }
+        else {
+            set->base[i] = set->nodes[n].target;
+            set->suffix[i] = p - set->ptrs[i];
+        }
+    }
+    return set;
+}
+
+void lept_pointer_set_free(lept_pointer_set* set) {
+    size_t i;
+    if (set == NULL)
+        return;
+    for (i = 0; i < set->count; i++)
+        lept_block_free(set->ptrs[i]);
+    free(set->ptrs);
+    free(set->nodes);
+    free(set->base);
+    free(set->suffix);
+    free(set);
+}
+
+typedef struct {
+    const lept_pointer_set* set;
+    lept_value* out;
+    int* found;
+    unsigned char* seen;    /* nodes already read: later duplicate keys are skipped */
+    size_t left;            /* pointers still to parse */
+}lept_pointer_scan_state;
+
+static int lept_pointer_scan(lept_context* c, lept_pointer_scan_state* s, size_t n);
+
+static int lept_pointer_scan_object(lept_context* c, lept_pointer_scan_state* s, size_t n) {
+    const char* key;
+    size_t klen, child;
+    int ret;
+    if (++c->depth > c->max_depth)
+        return LEPT_PARSE_NESTING_TOO_DEEP;
+    c->json++;
+    lept_parse_whitespace(c);
+    if (PEEK(c) == '}') {
+        c->json++;
+        c->depth--;
+        return LEPT_PARSE_OK;
+    }
+    for (;;) {
+        if (PEEK(c) != '"')
+            return LEPT_PARSE_MISS_KEY;
+        if ((ret = lept_pointer_key(c, &key, &klen)) != LEPT_PARSE_OK)
+            return ret;
+        for (child = s->set->nodes[n].child; child != 0; child = s->set->nodes[child].next)
+            if (lept_pointer_token_is(s->set->nodes[child].token, s->set->nodes[child].tlen, key, klen))
+                break;
+        lept_parse_whitespace(c);
+        if (PEEK(c) != ':')
+            return LEPT_PARSE_MISS_COLON;
+        c->json++;
+        lept_parse_whitespace(c);
+        if ((ret = child ? lept_pointer_scan(c, s, child) : lept_pointer_skip(c)) != LEPT_PARSE_OK || s->left == 0)
+            return ret;
+        lept_parse_whitespace(c);
+        if (PEEK(c) == ',') {
+            c->json++;
+            lept_parse_whitespace(c);
+        }
+        else if (PEEK(c) == '}') {
+            c->json++;
+            c->depth--;
+            return LEPT_PARSE_OK;
+        }
+        else
+            return LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET;
+    }
+}
+
+static int lept_pointer_scan_array(lept_context* c, lept_pointer_scan_state* s, size_t n) {
+    size_t i, child;
+    int ret;
+    if (++c->depth > c->max_depth)
+        return LEPT_PARSE_NESTING_TOO_DEEP;
+    c->json++;
+    lept_parse_whitespace(c);
+    if (PEEK(c) == ']') {
+        c->json++;
+        c->depth--;
+        return LEPT_PARSE_OK;
+    }
+    for (i = 0; ; i++) {
+        for (child = s->set->nodes[n].child; child != 0; child = s->set->nodes[child].next)
+            if (s->set->nodes[child].index == i)
+                break;
+        if ((ret = child ? lept_pointer_scan(c, s, child) : lept_pointer_skip(c)) != LEPT_PARSE_OK || s->left == 0)
+            return ret;
+        lept_parse_whitespace(c);
+        if (PEEK(c) == ',') {
+            c->json++;
+            lept_parse_whitespace(c);
+        }
+        else if (PEEK(c) == ']') {
+            c->json++;
+            c->depth--;
+            return LEPT_PARSE_OK;
+        }
+        else
+            return LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET;
+    }
+}
+
+/* Reads the value of node n at c->json: parses it if it is a target, else goes on with the
+   children of n in it, skipping everything else. */
+static int lept_pointer_scan(lept_context* c, lept_pointer_scan_state* s, size_t n) {
+    size_t target = s->set->nodes[n].target;
+    int ret;
+    if (s->seen[n]) /* the first of duplicate keys is the one pointers refer to */
+        return lept_pointer_skip(c);
+    s->seen[n] = 1;
+    if (target != LEPT_POINTER_NONE) {
+        if ((ret = lept_parse_value(c)) != LEPT_PARSE_OK)
+            return ret;
+        memcpy(&s->out[target], lept_context_pop(c, sizeof(lept_value)), sizeof(lept_value));
+        s->found[target] = 1;
+        s->left--;
+        return LEPT_PARSE_OK;
+    }
+    switch (PEEK(c)) {
+        case '{':  return lept_pointer_scan_object(c, s, n);
+        case '[':  return lept_pointer_scan_array(c, s, n);
+        default:   return lept_pointer_skip(c);
+    }
+}
+
+int lept_pointer_set_extract(const lept_pointer_set* set, const char* json, size_t len, lept_value* out, int* found) {
+    lept_context c;
+    lept_pointer_scan_state s;
+    size_t i;
+    int ret = LEPT_PARSE_OK;
+    assert(set != NULL && (out != NULL || set->count == 0) && (json != NULL || len == 0));
+    s.set = set;
+    s.out = out;
+    s.found = found ? found : (int*)malloc((set->count + 1) * sizeof(int));
+    s.seen = (unsigned char*)calloc(set->node_count, 1);
+    s.left = set->scanned;
+    for (i = 0; i < set->count; i++) {
+        lept_init(&out[i]);
+        s.found[i] = 0;
+    }
+    lept_context_init(&c, json, len);
+    c.handler = &lept_dom_handler;
+    c.user = &c;
+    lept_parse_whitespace(&c);
+    if (s.left > 0 && (ret = lept_pointer_scan(&c, &s, 0)) != LEPT_PARSE_OK) {
+        lept_dom_discard(&c);
+        for (i = 0; i < set->count; i++) {
+            lept_free(&out[i]);
+            s.found[i] = 0;
+        }
+    }
+    else
+        for (i = 0; i < set->count; i++) {
+            size_t base = set->base[i];
+            const lept_value* v;
+            if (base != LEPT_POINTER_NONE && s.found[base] && (v = lept_pointer_get(&out[base], set->ptrs[i] + set->suffix[i])) != NULL) {
+                lept_copy(&out[i], v);
+                s.found[i] = 1;
+            }
+        }
+    free(c.stack);
+    free(s.seen);
+    if (!found)
+        free(s.found);
+    return ret;
 }
@@ -2,6 +2,7 @@
 #define LEPTJSON_H__
 
 #include <stddef.h> /* size_t */
+#include <stdio.h>  /* FILE */
 
 typedef enum { LEPT_NULL, LEPT_FALSE, LEPT_TRUE, LEPT_NUMBER, LEPT_STRING, LEPT_ARRAY, LEPT_OBJECT } lept_type;
 
@@ -10,19 +11,55 @@ typedef enum { LEPT_NULL, LEPT_FALSE, LEPT_TRUE, LEPT_NUMBER, LEPT_STRING, LEPT_
 typedef struct lept_value lept_value;
 typedef struct lept_member lept_member;
 
+/* Define LEPT_COMPACT, for the library and all of its users alike, to get 16-byte values
+   (with 64-bit pointers) that hold sizes and lengths below 2^32 and strings of up to 7
+   bytes in place, instead of 32-byte values. */
+#ifdef LEPT_COMPACT
+
+typedef unsigned int lept_size;
+
+/* longest string stored inside the value itself */
+#define LEPT_SHORT_STRING_MAX (sizeof(double) - 1)
+
+struct lept_value {
+    union {
+        struct { lept_member* m; }o;                        /* object: members */
+        struct { lept_value*  e; }a;                        /* array:  elements */
+        struct { char* s; }s;                               /* string: null-terminated string */
+        struct { char s[LEPT_SHORT_STRING_MAX + 1]; }ss;    /* short string, in place */
+        struct { const char* json; }l;                      /* lazy array/object: its text */
+        double n;                                           /* number */
+    }u;
+    lept_size size;                                         /* member/element count, string/text length */
+    unsigned char type;                                     /* lept_type */
+    unsigned char flags;                                    /* ownership/placement of string/element/member/key storage */
+};
+
+#else
+
+typedef size_t lept_size;
+
+/* longest string stored inside the value itself: 22 bytes with 64-bit pointers */
+#define LEPT_SHORT_STRING_MAX (sizeof(lept_member*) + 2 * sizeof(size_t) - 2)
+
 struct lept_value {
     union {
         struct { lept_member* m; size_t size, capacity; }o; /* object: members, member count, capacity */
         struct { lept_value*  e; size_t size, capacity; }a; /* array:  elements, element count, capacity */
         struct { char* s; size_t len; }s;                   /* string: null-terminated string, string length */
+        struct { char s[LEPT_SHORT_STRING_MAX + 1]; unsigned char len; }ss; /* short string, in place */
+        struct { const char* json; size_t len; }l;          /* lazy array/object: its text, text length */
         double n;                                           /* number */
     }u;
     lept_type type;
+    unsigned char flags;                                    /* ownership/placement of string/element/member/key storage */
 };
 
+#endif
+
 struct lept_member {
-    char* k; size_t klen;   /* member key string, key string length */
-    lept_value v;           /* member value */
+    char* k; lept_size klen;    /* member key string, key string length */
+    lept_value v;               /* member value */
 };
 
 enum {
@@ -39,15 +76,115 @@ enum {
     LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET,
     LEPT_PARSE_MISS_KEY,
     LEPT_PARSE_MISS_COLON,
-    LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET
+    LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET,
+    LEPT_PARSE_NESTING_TOO_DEEP,
+    LEPT_PARSE_INVALID_POINTER,
+    LEPT_PARSE_POINTER_NOT_FOUND
 };
 
 #define lept_init(v) do { (v)->type = LEPT_NULL; } while(0)
 
+enum {
+    LEPT_ENGINE_RECURSIVE = 1,  /* recursive descent, one pass */
+    LEPT_ENGINE_INDEXED         /* a pass finding all tokens with SIMD, then one walking them; experimental,
+                                   and not faster yet, as stage 2 still parses scalars byte by byte */
+};
+
+/* zero fields take the defaults */
+typedef struct {
+    size_t max_depth;   /* deepest array/object nesting accepted, default LEPT_PARSE_MAX_DEPTH (1000) */
+    int engine;         /* LEPT_ENGINE_*, default LEPT_PARSE_ENGINE (recursive); both give the same results */
+    int lazy;           /* nonzero: arrays and objects below the root are only checked, and parsed when first
+                           accessed, from json, which must outlive them (and their copies); implies recursive.
+                           That first access writes even through const accessors, so a lazy document is not
+                           safe for concurrent reads until loaded; if json changed, it loads as empty. */
+}lept_parse_options;
+
+typedef struct lept_arena_block lept_arena_block;
+
+typedef struct {
+    lept_arena_block* head; /* newest (and largest) block, chained to older ones */
+    size_t used;            /* bytes used in head */
+}lept_arena;
+
+#define lept_arena_init(a) do { (a)->head = NULL; (a)->used = 0; } while(0)
+
+/* Event callbacks return LEPT_PARSE_OK to continue; any other value stops the parse and is returned.
+   Strings and keys are not null-terminated and only valid during the call. NULL callbacks are skipped. */
+typedef struct {
+    int (*on_null)(void* user);
+    int (*on_bool)(void* user, int b);
+    int (*on_number)(void* user, double n);
+    int (*on_string)(void* user, const char* s, size_t len);
+    int (*on_start_object)(void* user);
+    int (*on_key)(void* user, const char* k, size_t klen);
+    int (*on_end_object)(void* user, size_t size);  /* size: member count */
+    int (*on_start_array)(void* user);
+    int (*on_end_array)(void* user, size_t size);   /* size: element count */
+}lept_handler;
+
+typedef struct lept_parser lept_parser;
+
+/* Output goes through buf; when it is full, flush() must empty it (top = 0) or grow it by at
+   least need bytes, and returns nonzero on failure. After a failure the rest of the output is dropped. */
+typedef struct lept_writer lept_writer;
+
+struct lept_writer {
+    char* buf;
+    size_t size, top;                           /* buffer capacity, bytes written to it */
+    int (*flush)(lept_writer* w, size_t need);
+    void* user;                                 /* FILE* of file writers, free for custom ones */
+    int fd;                                     /* file descriptor of descriptor writers */
+    int error;                                  /* first nonzero flush() result */
+};
+
 int lept_parse(lept_value* v, const char* json);
+int lept_parse_n(lept_value* v, const char* json, size_t len);
+int lept_parse_ex(lept_value* v, const char* json, size_t len, const lept_parse_options* opts);
+int lept_parse_insitu(lept_value* v, char* json);
+/* The tree lives in a and is released all at once by lept_arena_reset() or lept_arena_destroy(),
+   without lept_free(). Changing it (setting strings, growing arrays and objects) moves parts of
+   it to the heap, which only lept_free() releases: call it on a changed tree before either. */
+int lept_parse_arena(lept_value* v, lept_arena* a, const char* json);
+int lept_parse_sax(const lept_handler* h, void* user, const char* json, size_t len);
+
+/* RFC 6901 JSON Pointers, such as "/a/0/b~1c" for the "b/c" member of the first element of "a" */
+const lept_value* lept_pointer_get(const lept_value* v, const char* ptr); /* NULL if absent or ptr is invalid */
+/* Parses only the value ptr refers to: values before it are skipped, checking only that their
+   brackets balance and strings end, and the text after it is not read. */
+int lept_pointer_extract(const char* json, size_t len, const char* ptr, lept_value* out);
+
+/* Pointers compiled to be extracted together in one scan of the text, read as far as the last
+   target, which is checked as by lept_pointer_extract(). */
+typedef struct lept_pointer_set lept_pointer_set;
+
+lept_pointer_set* lept_pointer_set_new(const char* const* ptrs, size_t count); /* NULL if one is invalid */
+void lept_pointer_set_free(lept_pointer_set* set);
+/* out[i] gets the value of the i-th pointer, null if absent, and found[i] (found may be NULL)
+   whether it is present; on error all are null */
+int lept_pointer_set_extract(const lept_pointer_set* set, const char* json, size_t len, lept_value* out, int* found);
+
+lept_parser* lept_parser_new(const lept_handler* h, void* user); /* h == NULL: build a lept_value */
+int lept_parser_feed(lept_parser* p, const char* chunk, size_t len);
+int lept_parser_finish(lept_parser* p, lept_value* v);
+void lept_parser_free(lept_parser* p);
 char* lept_stringify(const lept_value* v, size_t* length);
+int lept_stringify_to(const lept_value* v, lept_writer* w);
+size_t lept_stringify_size(const lept_value* v);
+size_t lept_stringify_into(const lept_value* v, char* buf, size_t cap); /* no '\0'; result > cap: buf too small */
+
+void lept_writer_init(lept_writer* w, char* buf, size_t size, int (*flush)(lept_writer* w, size_t need), void* user);
+void lept_writer_init_file(lept_writer* w, FILE* f, char* buf, size_t size);
+void lept_writer_init_fd(lept_writer* w, int fd, char* buf, size_t size);
+void lept_writer_init_buffer(lept_writer* w); /* grows with realloc(), caller frees w->buf */
+
+void lept_arena_reset(lept_arena* a);     /* keeps the largest block for the next parse */
+void lept_arena_destroy(lept_arena* a);
 
 void lept_copy(lept_value* dst, const lept_value* src);
+/* dst shares the storage of src (arena and in situ containers are copied), which is copied
+   when either is modified through a non-const function; reference counts are not thread-safe */
+void lept_share(lept_value* dst, const lept_value* src);
 void lept_move(lept_value* dst, lept_value* src);
 void lept_swap(lept_value* lhs, lept_value* rhs);
 
@@ -55,6 +192,7 @@ void lept_free(lept_value* v);
 
 lept_type lept_get_type(const lept_value* v);
 int lept_is_equal(const lept_value* lhs, const lept_value* rhs);
+size_t lept_hash(const lept_value* v); /* equal values hash equally, member order does not matter */
 
 #define lept_set_null(v) lept_free(v)
 
@@ -78,6 +216,7 @@ lept_value* lept_get_array_element(lept_value* v, size_t index);
 lept_value* lept_pushback_array_element(lept_value* v);
 void lept_popback_array_element(lept_value* v);
 lept_value* lept_insert_array_element(lept_value* v, size_t index);
+lept_value* lept_insert_array_elements(lept_value* v, size_t index, size_t count); /* count nulls, returns the first */
 void lept_erase_array_element(lept_value* v, size_t index, size_t count);
 
 void lept_set_object(lept_value* v, size_t capacity);
@@ -92,6 +231,30 @@ lept_value* lept_get_object_value(lept_value* v, size_t index);
 size_t lept_find_object_index(const lept_value* v, const char* key, size_t klen);
 lept_value* lept_find_object_value(lept_value* v, const char* key, size_t klen);
 lept_value* lept_set_object_value(lept_value* v, const char* key, size_t klen);
+void lept_set_object_values(lept_value* v, lept_member* members, size_t count); /* moves each members[i].v in */
 void lept_remove_object_value(lept_value* v, size_t index);
+void lept_swap_remove_object_value(lept_value* v, size_t index); /* moves the last member to index */
+
+/* A read-only document in a single block, freed with lept_tape_free(). Values are named by
+   their position: the root is at 0, and lept_tape_next() skips a value with its contents,
+   to the next element, or from a member value to the next key, of the enclosing container. */
+typedef struct lept_tape lept_tape;
+
+int lept_parse_tape(lept_tape** t, const char* json, size_t len); /* *t is NULL on error */
+void lept_tape_free(lept_tape* t);
+
+lept_type lept_tape_get_type(const lept_tape* t, size_t v);
+size_t lept_tape_next(const lept_tape* t, size_t v);
+int lept_tape_get_boolean(const lept_tape* t, size_t v);
+double lept_tape_get_number(const lept_tape* t, size_t v);
+const char* lept_tape_get_string(const lept_tape* t, size_t v);
+size_t lept_tape_get_string_length(const lept_tape* t, size_t v);
+size_t lept_tape_get_array_size(const lept_tape* t, size_t v);
+size_t lept_tape_get_array_element(const lept_tape* t, size_t v, size_t index);    /* walks index elements */
+size_t lept_tape_get_object_size(const lept_tape* t, size_t v);
+const char* lept_tape_get_object_key(const lept_tape* t, size_t v, size_t index);
+size_t lept_tape_get_object_key_length(const lept_tape* t, size_t v, size_t index);
+size_t lept_tape_get_object_value(const lept_tape* t, size_t v, size_t index);
+size_t lept_tape_find_object_value(const lept_tape* t, size_t v, const char* key, size_t klen); /* LEPT_KEY_NOT_EXIST if absent */
 
 #endif /* LEPTJSON_H__ */
@@ -102,6 +102,61 @@ static void test_parse_number() {
     TEST_NUMBER(-2.2250738585072014e-308, "-2.2250738585072014e-308");
     TEST_NUMBER( 1.7976931348623157e+308, "1.7976931348623157e+308");  /* Max double */
     TEST_NUMBER(-1.7976931348623157e+308, "-1.7976931348623157e+308");
+
+    /* fast and slow conversion paths */
+    TEST_NUMBER(0.1, "0.1");
+    TEST_NUMBER(0.0, "0e1000");
+    TEST_NUMBER(1e-6, "0.000001");
+    TEST_NUMBER(1.2345e-22, "12345e-26");
+    TEST_NUMBER(1e22, "1e22");
+    TEST_NUMBER(1e23, "1e23");
+    TEST_NUMBER(1.2345e30, "12345e26");
+    TEST_NUMBER(1e38, "1e38");
+    TEST_NUMBER(-123456789012345.0, "-123456789012345");
+    TEST_NUMBER(9007199254740991.0, "9007199254740991");
+    TEST_NUMBER(9007199254740993.0, "9007199254740993"); /* 2^53 + 1 rounds to even */
+    TEST_NUMBER(123456789012345678901234567890.0, "123456789012345678901234567890");
+    TEST_NUMBER(0.30000000000000004, "0.30000000000000004");
+    TEST_NUMBER(2.2250738585072011e-308, "2.2250738585072011e-308");
+
+    /* 17 to 19 digit significands and exact halfway cases */
+    TEST_NUMBER(9007199254740996.0, "9007199254740995"); /* 2^53 + 3 rounds to even */
+    TEST_NUMBER(7.3177701707893310e+15, "7.3177701707893310e+15");
+    TEST_NUMBER(0.1, "0.10000000000000000555");
+    TEST_NUMBER(18446744073709551616.0, "18446744073709551615");
+    TEST_NUMBER(9223372036854775808.0, "9223372036854775807");
+    TEST_NUMBER(1.7976931348623157e+308, "1.7976931348623158e+308");
+    TEST_NUMBER(0.0, "2.4703282292062327e-324"); /* just below half the minimum denormal */
+    TEST_NUMBER(4.9406564584124654e-324, "2.4703282292062328e-324");
+    TEST_NUMBER(1.0, "0.99999999999999999999999999999"); /* truncated past 19 digits */
+    TEST_NUMBER(9007199254740994.0, "9007199254740993.0000000000000000001");
+    TEST_NUMBER(1e22, "10000000000000000000000");
+}
+
+static void test_parse_number_17_digits() {
+    /* every double prints to 17 significant digits that parse back to the same bits */
+    unsigned long x = 12345;
+    char buf[32];
+    double d, n;
+    int i;
+    for (i = 0; i < 1000; i++) {
+        unsigned char bytes[sizeof(double)];
+        lept_value v;
+        size_t j;
+        for (j = 0; j < sizeof(bytes); j++) {
+            x = (x * 1103515245 + 12345) & 0x7FFFFFFF;
+            bytes[j] = (unsigned char)(x >> 16);
+        }
+        memcpy(&d, bytes, sizeof(d));
+        if (d != d || d - d != 0.0) /* NaN or infinity */
+            continue;
+        sprintf(buf, "%.17g", d);
+        lept_init(&v);
+        EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, buf));
+        n = lept_get_number(&v);
+        EXPECT_TRUE(memcmp(&n, &d, sizeof(d)) == 0);
+        lept_free(&v);
+    }
 }
 
 #define TEST_STRING(expect, json)\
@@ -125,6 +180,12 @@ static void test_parse_string() {
     TEST_STRING("\xE2\x82\xAC", "\"\\u20AC\""); /* Euro sign U+20AC */
     TEST_STRING("\xF0\x9D\x84\x9E", "\"\\uD834\\uDD1E\"");  /* G clef sign U+1D11E */
     TEST_STRING("\xF0\x9D\x84\x9E", "\"\\ud834\\udd1e\"");  /* G clef sign U+1D11E */
+
+    /* long runs of unescaped characters */
+    TEST_STRING("0123456789abcdef0123456789ABCDEF0123456789abcdef0123456789ABCDEF",
+        "\"0123456789abcdef0123456789ABCDEF0123456789abcdef0123456789ABCDEF\"");
+    TEST_STRING("0123456789abcdef0123456789ABCDEF\"0123456789abcdef\n0123456789ABCDE\xC2\xA2",
+        "\"0123456789abcdef0123456789ABCDEF\\\"0123456789abcdef\\n0123456789ABCDE\\u00A2\"");
 }
 
 static void test_parse_array() {
@@ -226,6 +287,290 @@ static void test_parse_object() {
     lept_free(&v);
 }
 
+static void test_parse_whitespace() {
+    lept_value v;
+
+    lept_init(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v,
+        "{\n"
+        "    \"a\": [\n"
+        "        1,\n"
+        "\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t2\r\n"
+        "                                                                      ]\r\n"
+        "}                                                                    "
+    ));
+    EXPECT_EQ_INT(LEPT_OBJECT, lept_get_type(&v));
+    EXPECT_EQ_SIZE_T(2, lept_get_array_size(lept_get_object_value(&v, 0)));
+    lept_free(&v);
+
+    TEST_NUMBER(1.0, "                                                      1                                  ");
+}
+
+static void test_parse_arena() {
+    lept_arena a;
+    lept_value v;
+    size_t i;
+
+    lept_arena_init(&a);
+    for (i = 0; i < 2; i++) {
+        lept_init(&v);
+        EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_arena(&v, &a, "{\"s\":\"abc\",\"a\":[1,\"x\",{\"k\":null}]}"));
+        EXPECT_EQ_INT(LEPT_OBJECT, lept_get_type(&v));
+        EXPECT_EQ_SIZE_T(2, lept_get_object_size(&v));
+        EXPECT_EQ_STRING("s", lept_get_object_key(&v, 0), lept_get_object_key_length(&v, 0));
+        EXPECT_EQ_STRING("abc", lept_get_string(lept_get_object_value(&v, 0)), lept_get_string_length(lept_get_object_value(&v, 0)));
+        EXPECT_EQ_SIZE_T(3, lept_get_array_size(lept_get_object_value(&v, 1)));
+        lept_arena_reset(&a);   /* releases the whole document */
+    }
+
+    /* growing an arena array moves it to the heap */
+    lept_init(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_arena(&v, &a, "[\"a\",\"b\"]"));
+    lept_set_string(lept_pushback_array_element(&v), "c", 1);
+    EXPECT_EQ_SIZE_T(3, lept_get_array_size(&v));
+    EXPECT_EQ_STRING("a", lept_get_string(lept_get_array_element(&v, 0)), lept_get_string_length(lept_get_array_element(&v, 0)));
+    EXPECT_EQ_STRING("c", lept_get_string(lept_get_array_element(&v, 2)), lept_get_string_length(lept_get_array_element(&v, 2)));
+    lept_free(&v);          /* only frees what lives on the heap */
+
+    /* so does setting a long string in it */
+    lept_init(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_arena(&v, &a, "[\"a\",\"b\"]"));
+    lept_set_string(lept_get_array_element(&v, 1), "abcdefghijklmnopqrstuvwxyz", 26);
+    EXPECT_EQ_STRING("abcdefghijklmnopqrstuvwxyz", lept_get_string(lept_get_array_element(&v, 1)), lept_get_string_length(lept_get_array_element(&v, 1)));
+    lept_free(&v);
+
+    lept_init(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET, lept_parse_arena(&v, &a, "{\"a\":\"b\""));
+    EXPECT_EQ_INT(LEPT_NULL, lept_get_type(&v));
+    lept_arena_destroy(&a);
+}
+
+static void test_parse_n() {
+    lept_value v;
+    char buf[8];
+
+    /* the input is not terminated */
+    memcpy(buf, "12345678", 8);
+    lept_init(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_n(&v, buf, 3));
+    EXPECT_EQ_DOUBLE(123.0, lept_get_number(&v));
+    lept_free(&v);
+
+    memcpy(buf, "\"ab\"cdef", 8);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_n(&v, buf, 4));
+    EXPECT_EQ_STRING("ab", lept_get_string(&v), lept_get_string_length(&v));
+    lept_free(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_MISS_QUOTATION_MARK, lept_parse_n(&v, buf, 3));
+    EXPECT_EQ_INT(LEPT_NULL, lept_get_type(&v));
+
+    memcpy(buf, "[true]xx", 8);
+    EXPECT_EQ_INT(LEPT_PARSE_INVALID_VALUE, lept_parse_n(&v, buf, 4));
+    EXPECT_EQ_INT(LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET, lept_parse_n(&v, buf, 5));
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_n(&v, buf, 6));
+    EXPECT_EQ_SIZE_T(1, lept_get_array_size(&v));
+    lept_free(&v);
+
+    /* embedded terminator after the document is not silently accepted */
+    EXPECT_EQ_INT(LEPT_PARSE_ROOT_NOT_SINGULAR, lept_parse_n(&v, "null\0x", 6));
+    EXPECT_EQ_INT(LEPT_PARSE_ROOT_NOT_SINGULAR, lept_parse_n(&v, "null \0", 6));
+    EXPECT_EQ_INT(LEPT_PARSE_INVALID_STRING_CHAR, lept_parse_n(&v, "\"a\0b\"", 5));
+    EXPECT_EQ_INT(LEPT_PARSE_EXPECT_VALUE, lept_parse_n(&v, "", 0));
+    EXPECT_EQ_INT(LEPT_NULL, lept_get_type(&v));
+}
+
+static void test_parse_insitu() {
+    char json[] = "{\"a\\tb\":[\"Hello\\nWorld\",\"\\u20AC\\uD834\\uDD1E is longer than short strings\"],\"c\":\"d\"}";
+    lept_value v, *a;
+
+    lept_init(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_insitu(&v, json));
+    EXPECT_EQ_SIZE_T(2, lept_get_object_size(&v));
+    EXPECT_EQ_STRING("a\tb", lept_get_object_key(&v, 0), lept_get_object_key_length(&v, 0));
+    EXPECT_TRUE(lept_get_object_key(&v, 0) >= json && lept_get_object_key(&v, 0) < json + sizeof(json));
+    a = lept_get_object_value(&v, 0);
+    EXPECT_EQ_STRING("Hello\nWorld", lept_get_string(lept_get_array_element(a, 0)), lept_get_string_length(lept_get_array_element(a, 0)));
+    EXPECT_EQ_STRING("\xE2\x82\xAC\xF0\x9D\x84\x9E is longer than short strings", lept_get_string(lept_get_array_element(a, 1)), lept_get_string_length(lept_get_array_element(a, 1)));
+    EXPECT_TRUE(lept_get_string(lept_get_array_element(a, 1)) >= json && lept_get_string(lept_get_array_element(a, 1)) < json + sizeof(json));
+    EXPECT_EQ_STRING("c", lept_get_object_key(&v, 1), lept_get_object_key_length(&v, 1));
+    EXPECT_EQ_STRING("d", lept_get_string(lept_get_object_value(&v, 1)), lept_get_string_length(lept_get_object_value(&v, 1)));
+    lept_set_string(lept_get_array_element(a, 0), "abc", 3); /* must not free the buffer */
+    lept_free(&v);
+}
+
+typedef struct {
+    char trace[64];
+    size_t len, sizes;
+    double sum;
+    const char* stop_key;
+    int stop;
+}sax_recorder;
+
+static int sax_event(void* user, char ev) {
+    sax_recorder* r = (sax_recorder*)user;
+    r->trace[r->len++] = ev;
+    r->trace[r->len] = '\0';
+    if (r->stop) /* the value after the stop key has been seen */
+        return LEPT_PARSE_INVALID_VALUE;
+    return LEPT_PARSE_OK;
+}
+
+static int sax_null(void* user) { return sax_event(user, 'n'); }
+static int sax_bool(void* user, int b) { return sax_event(user, b ? 't' : 'f'); }
+static int sax_number(void* user, double n) { ((sax_recorder*)user)->sum += n; return sax_event(user, '#'); }
+static int sax_string(void* user, const char* s, size_t len) { (void)s; (void)len; return sax_event(user, 's'); }
+static int sax_start_object(void* user) { return sax_event(user, '{'); }
+static int sax_start_array(void* user) { return sax_event(user, '['); }
+static int sax_end_object(void* user, size_t size) { ((sax_recorder*)user)->sizes += size; return sax_event(user, '}'); }
+static int sax_end_array(void* user, size_t size) { ((sax_recorder*)user)->sizes += size; return sax_event(user, ']'); }
+
+static int sax_key(void* user, const char* k, size_t klen) {
+    sax_recorder* r = (sax_recorder*)user;
+    if (r->stop_key && strlen(r->stop_key) == klen && memcmp(r->stop_key, k, klen) == 0) {
+        sax_event(user, 'k');
+        r->stop = 1;
+        return LEPT_PARSE_OK;
+    }
+    return sax_event(user, 'k');
+}
+
+static void test_parse_sax() {
+    static const char json[] = " { \"n\" : null , \"f\" : false , \"t\" : true , \"i\" : 123 , \"s\" : \"a\\u0062c\" ,"
+        " \"a\" : [ 1, 2, 3, [] ], \"o\" : { \"1\" : 1, \"2\" : 2 } } ";
+    lept_handler h;
+    sax_recorder r;
+
+    memset(&h, 0, sizeof(h));
+    h.on_null = sax_null;
+    h.on_bool = sax_bool;
+    h.on_number = sax_number;
+    h.on_string = sax_string;
+    h.on_start_object = sax_start_object;
+    h.on_key = sax_key;
+    h.on_end_object = sax_end_object;
+    h.on_start_array = sax_start_array;
+    h.on_end_array = sax_end_array;
+
+    memset(&r, 0, sizeof(r));
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_sax(&h, &r, json, sizeof(json) - 1));
+    EXPECT_EQ_STRING("{knkfktk#ksk[###[]]k{k#k#}}", r.trace, r.len);
+    EXPECT_EQ_SIZE_T(7 + 4 + 0 + 2, r.sizes);
+    EXPECT_EQ_DOUBLE(132.0, r.sum);
+
+    /* a callback can stop the parse with its own code */
+    memset(&r, 0, sizeof(r));
+    r.stop_key = "i";
+    EXPECT_EQ_INT(LEPT_PARSE_INVALID_VALUE, lept_parse_sax(&h, &r, json, sizeof(json) - 1));
+    EXPECT_EQ_STRING("{knkfktk#", r.trace, r.len);
+
+    /* unset callbacks are skipped */
+    memset(&r, 0, sizeof(r));
+    h.on_null = NULL;
+    h.on_key = NULL;
+    h.on_start_object = h.on_start_array = NULL;
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_sax(&h, &r, json, sizeof(json) - 1));
+    EXPECT_EQ_STRING("ft#s###]]##}}", r.trace, r.len);
+
+    /* grammar errors are the same as the DOM parser's */
+    memset(&r, 0, sizeof(r));
+    EXPECT_EQ_INT(LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET, lept_parse_sax(&h, &r, "[1 2]", 5));
+    EXPECT_EQ_INT(LEPT_PARSE_ROOT_NOT_SINGULAR, lept_parse_sax(&h, &r, "1 2", 3));
+    EXPECT_EQ_INT(LEPT_PARSE_EXPECT_VALUE, lept_parse_sax(&h, &r, NULL, 0));
+}
+
+/* feeds json split at every position, and byte by byte, and compares with lept_parse() */
+static void test_parse_push_json(const char* json) {
+    size_t len = strlen(json), i, j, expect_len, actual_len;
+    lept_value expect, v;
+    char* expect_json = NULL;
+    int expect_ret;
+
+    lept_init(&expect);
+    if ((expect_ret = lept_parse(&expect, json)) == LEPT_PARSE_OK)
+        expect_json = lept_stringify(&expect, &expect_len);
+    for (i = 0; i <= len + 1; i++) {
+        lept_parser* p = lept_parser_new(NULL, NULL);
+        if (i <= len) {
+            lept_parser_feed(p, json, i);
+            lept_parser_feed(p, json + i, len - i);
+        }
+        else
+            for (j = 0; j < len; j++)
+                lept_parser_feed(p, json + j, 1);
+        v.type = LEPT_FALSE;
+        EXPECT_EQ_INT(expect_ret, lept_parser_finish(p, &v));
+        if (expect_ret == LEPT_PARSE_OK) {
+            char* actual_json = lept_stringify(&v, &actual_len);
+            EXPECT_EQ_SIZE_T(expect_len, actual_len);
+            EXPECT_TRUE(memcmp(expect_json, actual_json, actual_len) == 0);
+            free(actual_json);
+        }
+        else
+            EXPECT_EQ_INT(LEPT_NULL, lept_get_type(&v));
+        lept_free(&v);
+        lept_parser_free(p);
+    }
+    free(expect_json);
+    lept_free(&expect);
+}
+
+static void test_parse_push() {
+    lept_handler h;
+    sax_recorder r;
+    lept_parser* p;
+
+    test_parse_push_json(" [ null , false , true , 123 , -1.5e+10 , \"abc\" , [ ] , { } ] ");
+    test_parse_push_json("{\"n\":null,\"a\":[1,[2,[3]]],\"o\":{\"\\u0041\\t\":\"\\uD834\\uDD1E\\\\\\\"\"}}");
+    test_parse_push_json("\"\\\\\\\\\\\"\"");
+    test_parse_push_json("0.1234567890123456789e-5");
+    test_parse_push_json("[[[[[[[[[[]]]]]]]]]]");
+
+    /* errors, including ones only the end of input reveals */
+    test_parse_push_json("");
+    test_parse_push_json("[");
+    test_parse_push_json("[1,");
+    test_parse_push_json("[1,]");
+    test_parse_push_json("[1 2]");
+    test_parse_push_json("{");
+    test_parse_push_json("{\"a\"");
+    test_parse_push_json("{\"a\":");
+    test_parse_push_json("{\"a\":1");
+    test_parse_push_json("{\"a\":1 \"b\"");
+    test_parse_push_json("{1:1}");
+    test_parse_push_json("nul");
+    test_parse_push_json("truex");
+    test_parse_push_json("0123");
+    test_parse_push_json("1e");
+    test_parse_push_json("1e309");
+    test_parse_push_json("\"abc");
+    test_parse_push_json("\"\\u12");
+    test_parse_push_json("\"\\uD834\\u0041\"");
+    test_parse_push_json("\"\\q\"");
+    test_parse_push_json("\"\x01\"");
+    test_parse_push_json("null x");
+
+    /* events go to a handler as soon as their input is complete */
+    memset(&h, 0, sizeof(h));
+    h.on_number = sax_number;
+    h.on_start_array = sax_start_array;
+    h.on_end_array = sax_end_array;
+    memset(&r, 0, sizeof(r));
+    p = lept_parser_new(&h, &r);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parser_feed(p, "[1, 2", 5));
+    EXPECT_EQ_STRING("[#", r.trace, r.len);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parser_feed(p, "3]", 2));
+    EXPECT_EQ_STRING("[##]", r.trace, r.len);
+    EXPECT_EQ_DOUBLE(24.0, r.sum);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parser_finish(p, NULL));
+    lept_parser_free(p);
+
+    /* errors are sticky, and an unfinished parser frees what it has built */
+    p = lept_parser_new(NULL, NULL);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parser_feed(p, "[\"abc\", {\"a\": [\"b\"", 18));
+    EXPECT_EQ_INT(LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET, lept_parser_feed(p, " 1", 2));
+    EXPECT_EQ_INT(LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET, lept_parser_feed(p, "]}]", 3));
+    lept_parser_free(p);
+}
+
 #define TEST_PARSE_ERROR(error, json)\
     do {\
         lept_value v;\
@@ -272,11 +617,13 @@ static void test_parse_root_not_singular() {
 static void test_parse_number_too_big() {
     TEST_PARSE_ERROR(LEPT_PARSE_NUMBER_TOO_BIG, "1e309");
     TEST_PARSE_ERROR(LEPT_PARSE_NUMBER_TOO_BIG, "-1e309");
+    TEST_PARSE_ERROR(LEPT_PARSE_NUMBER_TOO_BIG, "1.7976931348623159e+308");
 }
 
 static void test_parse_miss_quotation_mark() {
     TEST_PARSE_ERROR(LEPT_PARSE_MISS_QUOTATION_MARK, "\"");
     TEST_PARSE_ERROR(LEPT_PARSE_MISS_QUOTATION_MARK, "\"abc");
+    TEST_PARSE_ERROR(LEPT_PARSE_MISS_QUOTATION_MARK, "\"0123456789abcdef0123456789ABCDEF0123456789abcdef");
 }
 
 static void test_parse_invalid_string_escape() {
@@ -289,6 +636,8 @@ static void test_parse_invalid_string_escape() {
 static void test_parse_invalid_string_char() {
     TEST_PARSE_ERROR(LEPT_PARSE_INVALID_STRING_CHAR, "\"\x01\"");
     TEST_PARSE_ERROR(LEPT_PARSE_INVALID_STRING_CHAR, "\"\x1F\"");
+    TEST_PARSE_ERROR(LEPT_PARSE_INVALID_STRING_CHAR, "\"0123456789abcdef0123456789\x01" "BCDEF0123456789abcdef\"");
+    TEST_PARSE_ERROR(LEPT_PARSE_INVALID_STRING_CHAR, "\"0123456789abcdef0123456789ABCDEF0123456789a\x1F\"");
 }
 
 static void test_parse_invalid_unicode_hex() {
@@ -345,14 +694,282 @@ static void test_parse_miss_comma_or_curly_bracket() {
     TEST_PARSE_ERROR(LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET, "{\"a\":{}");
 }
 
+static void test_parse_nesting_too_deep() {
+    char* json = (char*)malloc(8 * 1001 + 1);
+    lept_parse_options options;
+    lept_parser* p;
+    lept_handler h;
+    lept_value v;
+    size_t i, n;
+
+    /* the default limit */
+    for (n = 1000; n <= 1001; n++) {
+        for (i = 0; i < n; i++) {
+            json[i] = '[';
+            json[2 * n - 1 - i] = ']';
+        }
+        json[2 * n] = '\0';
+        if (n == 1000) {
+            lept_init(&v);
+            EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, json));
+            lept_free(&v);
+        }
+        else
+            TEST_PARSE_ERROR(LEPT_PARSE_NESTING_TOO_DEEP, json);
+    }
+    memset(&h, 0, sizeof(h));
+    EXPECT_EQ_INT(LEPT_PARSE_NESTING_TOO_DEEP, lept_parse_sax(&h, NULL, json, 2 * n - 2));
+    p = lept_parser_new(NULL, NULL);
+    EXPECT_EQ_INT(LEPT_PARSE_NESTING_TOO_DEEP, lept_parser_feed(p, json, 2 * n - 2));
+    lept_parser_free(p);
+
+    for (i = 0; i < 1001; i++) {
+        memcpy(json + 6 * i, "{\"a\":[", 6);
+        memcpy(json + 6 * 1001 + 2 * i, "]}", 2);
+    }
+    json[8 * 1001] = '\0';
+    TEST_PARSE_ERROR(LEPT_PARSE_NESTING_TOO_DEEP, json);
+    free(json);
+
+    memset(&options, 0, sizeof(options));
+    options.max_depth = 2;
+    lept_init(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_ex(&v, "[[1],{\"a\":2}]", 13, &options));
+    lept_free(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_NESTING_TOO_DEEP, lept_parse_ex(&v, "[[1],{\"a\":[]}]", 14, &options));
+    EXPECT_EQ_INT(LEPT_NULL, lept_get_type(&v));
+    EXPECT_EQ_INT(LEPT_PARSE_NESTING_TOO_DEEP, lept_parse_ex(&v, "{\"a\":[[]]}", 10, &options));
+    lept_free(&v);
+}
+
+static void test_parse_engine(const char* json, size_t len) {
+    lept_parse_options options;
+    lept_value v1, v2;
+    int ret;
+    memset(&options, 0, sizeof(options));
+    lept_init(&v1);
+    lept_init(&v2);
+    options.engine = LEPT_ENGINE_RECURSIVE;
+    ret = lept_parse_ex(&v1, json, len, &options);
+    options.engine = LEPT_ENGINE_INDEXED;
+    EXPECT_EQ_INT(ret, lept_parse_ex(&v2, json, len, &options));
+    EXPECT_TRUE(lept_is_equal(&v1, &v2));
+    lept_free(&v1);
+    lept_free(&v2);
+}
+
+static void test_parse_engines() {
+    static const char* const cases[] = {
+        "", " ", "null", " true ", "false x", "nul", "[1,2", "[1,]", "[1 2]", "[1x]", "[\"a\"x]",
+        "{\"a\":1,\"b\":[true,{}]}", "{\"a\" 1}", "{1:1}", "{\"a\":1,}", "{\"a\":1 \"b\":2}", "{\"a\":}",
+        "\"\\\"\\\\\"", "\"\\\\\\\"\"", "\"a\\x\"", "\"\\u12\"", "\"\\uD800\"", "\"\x01\"", "\"abc",
+        "1e309", "-", "01", "1.", "[[[[]]]]", "[[[[", "]", "}", ":", ",", "\\\"[]", "[\"\\\\\"]x",
+        "[1}", "{\"a\":1]", "{\"a\"x:1}", "{\"a\":1x}", "truex", "[", "{", "{\"a\"", "{\"a\":1", "[1,{\"a\":[2,"
+    };
+    char* json = (char*)malloc(65536);
+    size_t i, j, n;
+
+    for (i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+        test_parse_engine(cases[i], strlen(cases[i]));
+    test_parse_engine("[\"a\0b\"]", 7);
+
+    /* backslash runs, quotes and tokens at every offset of the 64-byte blocks of the index */
+    n = 0;
+    json[n++] = '[';
+    for (i = 0; i < 130; i++) {
+        n += sprintf(json + n, "%s%*s\"", i ? "," : "", (int)(i % 7), "");
+        for (j = 0; j < i % 67; j++)
+            n += sprintf(json + n, j % 5 == 4 ? "\\\"" : "\\\\");
+        n += sprintf(json + n, "\"%s", i % 3 ? "" : ",{\"k\":[1, -2.5e1 ,null]}");
+    }
+    json[n++] = ']';
+    test_parse_engine(json, n);
+    for (i = 1; i < n; i += 7)
+        test_parse_engine(json, i);
+    free(json);
+}
+
+static void test_parse_lazy_case(const char* json) {
+    lept_parse_options options;
+    lept_value v1, v2;
+    int ret;
+    memset(&options, 0, sizeof(options));
+    lept_init(&v1);
+    lept_init(&v2);
+    ret = lept_parse(&v1, json);
+    options.lazy = 1;
+    EXPECT_EQ_INT(ret, lept_parse_ex(&v2, json, strlen(json), &options));
+    EXPECT_EQ_SIZE_T(lept_hash(&v1), lept_hash(&v2));
+    EXPECT_TRUE(lept_is_equal(&v1, &v2));
+    lept_free(&v1);
+    lept_free(&v2);
+}
+
+static void test_parse_lazy() {
+    static const char* const cases[] = {
+        "null", "[]", "{}", "[[]]", "[[],{}]", "[1,[2,[3,[4]]],{\"a\":{\"b\":[5]}}]",
+        "{\"a\":[\"]\\\"[\",{\"b\":\"}\\\\\"}],\"c\":[ \"\\\\\" , { } ] , \"d\":{\"[\":\"{\"}}",
+        "[1,[2,x]]", "[1,[2,3]", "{\"a\":{\"b\":1,}}", "[[\"\\u12\"]]", "[[1] ,]"
+    };
+    lept_parse_options options;
+    lept_value v, c;
+    char* json;
+    char* s;
+    size_t i;
+
+    for (i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+        test_parse_lazy_case(cases[i]);
+
+    memset(&options, 0, sizeof(options));
+    options.lazy = 1;
+    options.max_depth = 2;
+    lept_init(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_NESTING_TOO_DEEP, lept_parse_ex(&v, "[[[]]]", 6, &options));
+    EXPECT_EQ_INT(LEPT_NULL, lept_get_type(&v));
+    options.max_depth = 0;
+
+    /* nested containers are parsed from the text when first accessed */
+    json = (char*)malloc(64);
+    strcpy(json, "{\"a\":[1,{\"b\":2}],\"c\":{\"d\":[3]}}");
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_ex(&v, json, strlen(json), &options));
+    EXPECT_EQ_SIZE_T(2, lept_get_object_size(&v));
+    EXPECT_EQ_INT(LEPT_OBJECT, lept_get_type(lept_find_object_value(&v, "c", 1)));
+    json[13] = '7';
+    json[27] = '9';
+    EXPECT_EQ_DOUBLE(7.0, lept_get_number(lept_find_object_value(lept_get_array_element(lept_find_object_value(&v, "a", 1), 1), "b", 1)));
+    lept_init(&c);
+    lept_copy(&c, &v);
+    json[27] = '8';
+    EXPECT_EQ_DOUBLE(8.0, lept_get_number(lept_get_array_element(lept_get_object_value(lept_find_object_value(&c, "c", 1), 0), 0)));
+    lept_set_number(lept_pushback_array_element(lept_get_object_value(lept_find_object_value(&v, "c", 1), 0)), 4.0);
+    s = lept_stringify(&v, NULL);
+    EXPECT_EQ_STRING("{\"a\":[1,{\"b\":7}],\"c\":{\"d\":[8,4]}}", s, strlen(s));
+    free(s);
+
+    /* text that stopped parsing loads as an empty container */
+    lept_free(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_ex(&v, json, strlen(json), &options));
+    json[6] = 'x';
+    EXPECT_EQ_INT(LEPT_ARRAY, lept_get_type(lept_find_object_value(&v, "a", 1)));
+    EXPECT_EQ_SIZE_T(0, lept_get_array_size(lept_find_object_value(&v, "a", 1)));
+    s = lept_stringify(&v, NULL);
+    EXPECT_EQ_STRING("{\"a\":[],\"c\":{\"d\":[8]}}", s, strlen(s));
+    free(s);
+    free(json);
+    lept_free(&v);
+    lept_free(&c);
+
+    /* or whose brackets and strings no longer close, without reading past it */
+    json = (char*)malloc(8);
+    memcpy(json, "[[[1]]]", 7);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_ex(&v, json, 7, &options));
+    memcpy(json, "[[[[[[[", 7);
+    EXPECT_EQ_SIZE_T(0, lept_get_array_size(lept_get_array_element(&v, 0)));
+    lept_free(&v);
+    memcpy(json, "[[\"a\"]]", 7);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_ex(&v, json, 7, &options));
+    memcpy(json, "[[[\"\\\"\\", 7);
+    EXPECT_EQ_SIZE_T(0, lept_get_array_size(lept_get_array_element(&v, 0)));
+    lept_free(&v);
+    free(json);
+}
+
+/* checks the tape value at pos against the DOM value, returns the position after it */
+static size_t test_tape_value(const lept_tape* t, size_t pos, lept_value* v) {
+    size_t i, next;
+    EXPECT_EQ_INT(lept_get_type(v), lept_tape_get_type(t, pos));
+    switch (lept_get_type(v)) {
+        case LEPT_TRUE:
+        case LEPT_FALSE:
+            EXPECT_EQ_INT(lept_get_boolean(v), lept_tape_get_boolean(t, pos));
+            break;
+        case LEPT_NUMBER:
+            EXPECT_EQ_DOUBLE(lept_get_number(v), lept_tape_get_number(t, pos));
+            break;
+        case LEPT_STRING:
+            EXPECT_EQ_SIZE_T(lept_get_string_length(v), lept_tape_get_string_length(t, pos));
+            EXPECT_TRUE(memcmp(lept_get_string(v), lept_tape_get_string(t, pos), lept_get_string_length(v) + 1) == 0);
+            break;
+        case LEPT_ARRAY:
+            EXPECT_EQ_SIZE_T(lept_get_array_size(v), lept_tape_get_array_size(t, pos));
+            for (i = 0, next = pos + 2; i < lept_get_array_size(v); i++) {
+                EXPECT_EQ_SIZE_T(next, lept_tape_get_array_element(t, pos, i));
+                next = test_tape_value(t, next, lept_get_array_element(v, i));
+            }
+            EXPECT_EQ_SIZE_T(next, lept_tape_next(t, pos));
+            break;
+        case LEPT_OBJECT:
+            EXPECT_EQ_SIZE_T(lept_get_object_size(v), lept_tape_get_object_size(t, pos));
+            for (i = 0, next = pos + 2; i < lept_get_object_size(v); i++) {
+                EXPECT_EQ_SIZE_T(lept_get_object_key_length(v, i), lept_tape_get_object_key_length(t, pos, i));
+                EXPECT_TRUE(memcmp(lept_get_object_key(v, i), lept_tape_get_object_key(t, pos, i), lept_get_object_key_length(v, i) + 1) == 0);
+                EXPECT_EQ_SIZE_T(next + 2, lept_tape_get_object_value(t, pos, i));
+                next = test_tape_value(t, next + 2, lept_get_object_value(v, i));
+            }
+            EXPECT_EQ_SIZE_T(next, lept_tape_next(t, pos));
+            break;
+        default:
+            break;
+    }
+    return lept_tape_next(t, pos);
+}
+
+static void test_parse_tape() {
+    static const char* const cases[] = {
+        "null", "true", "false", "-1.5e3", "\"\"", "\"Hello\\u0000World\"", "[]", "{}",
+        "[null,false,true,123,\"abc\",[1,[2,[3]]],{\"a\":{}}]",
+        " { \"n\" : null , \"f\" : false , \"t\" : true , \"i\" : 123 , \"s\" : \"abc\", "
+        "\"a\" : [ 1, 2, 3 ], \"o\" : { \"1\" : 1, \"2\" : [2, {\"3\": []}], \"3\" : 3 } } "
+    };
+    const char* json = "{\"a\":[1,{\"b\":2}],\"\":\"x\",\"c\":{\"a\":true}}";
+    lept_tape* t;
+    lept_value v;
+    size_t i, a;
+
+    for (i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        lept_init(&v);
+        EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, cases[i]));
+        EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_tape(&t, cases[i], strlen(cases[i])));
+        test_tape_value(t, 0, &v);
+        lept_tape_free(t);
+        lept_free(&v);
+    }
+
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_tape(&t, json, strlen(json)));
+    a = lept_tape_find_object_value(t, 0, "a", 1);
+    EXPECT_EQ_INT(LEPT_ARRAY, lept_tape_get_type(t, a));
+    EXPECT_EQ_DOUBLE(2.0, lept_tape_get_number(t, lept_tape_find_object_value(t, lept_tape_get_array_element(t, a, 1), "b", 1)));
+    EXPECT_EQ_STRING("x", lept_tape_get_string(t, lept_tape_find_object_value(t, 0, "", 0)), (size_t)1);
+    EXPECT_EQ_INT(LEPT_TRUE, lept_tape_get_type(t, lept_tape_find_object_value(t, lept_tape_get_object_value(t, 0, 2), "a", 1)));
+    EXPECT_EQ_SIZE_T(LEPT_KEY_NOT_EXIST, lept_tape_find_object_value(t, 0, "b", 1));
+    lept_tape_free(t);
+
+    t = (lept_tape*)&v;
+    EXPECT_EQ_INT(LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET, lept_parse_tape(&t, "{\"a\":[1,{\"b\":2}]", 16));
+    EXPECT_TRUE(t == NULL);
+    EXPECT_EQ_INT(LEPT_PARSE_ROOT_NOT_SINGULAR, lept_parse_tape(&t, "[] x", 4));
+    EXPECT_TRUE(t == NULL);
+    EXPECT_EQ_INT(LEPT_PARSE_EXPECT_VALUE, lept_parse_tape(&t, "", 0));
+    EXPECT_TRUE(t == NULL);
+}
+
 static void test_parse() {
     test_parse_null();
     test_parse_true();
     test_parse_false();
     test_parse_number();
+    test_parse_number_17_digits();
     test_parse_string();
     test_parse_array();
     test_parse_object();
+    test_parse_whitespace();
+    test_parse_arena();
+    test_parse_n();
+    test_parse_insitu();
+    test_parse_sax();
+    test_parse_push();
+    test_parse_tape();
+    test_parse_lazy();
 
     test_parse_expect_value();
     test_parse_invalid_value();
@@ -367,6 +984,8 @@ static void test_parse() {
     test_parse_miss_key();
     test_parse_miss_colon();
     test_parse_miss_comma_or_curly_bracket();
+    test_parse_nesting_too_deep();
+    test_parse_engines();
 }
 
 #define TEST_ROUNDTRIP(json)\
@@ -382,6 +1001,19 @@ static void test_parse() {
         free(json2);\
     } while(0)
 
+#define TEST_STRINGIFY_NUMBER(expect, n)\
+    do {\
+        lept_value v;\
+        char* json;\
+        size_t length;\
+        lept_init(&v);\
+        lept_set_number(&v, n);\
+        json = lept_stringify(&v, &length);\
+        EXPECT_EQ_STRING(expect, json, length);\
+        lept_free(&v);\
+        free(json);\
+    } while(0)
+
 static void test_stringify_number() {
     TEST_ROUNDTRIP("0");
     TEST_ROUNDTRIP("-0");
@@ -395,14 +1027,40 @@ static void test_stringify_number() {
     TEST_ROUNDTRIP("1.234e-20");
 
     TEST_ROUNDTRIP("1.0000000000000002"); /* the smallest number > 1 */
-    TEST_ROUNDTRIP("4.9406564584124654e-324"); /* minimum denormal */
-    TEST_ROUNDTRIP("-4.9406564584124654e-324");
-    TEST_ROUNDTRIP("2.2250738585072009e-308");  /* Max subnormal double */
-    TEST_ROUNDTRIP("-2.2250738585072009e-308");
+    TEST_ROUNDTRIP("5e-324"); /* minimum denormal */
+    TEST_ROUNDTRIP("-5e-324");
+    TEST_ROUNDTRIP("2.225073858507201e-308");  /* Max subnormal double */
+    TEST_ROUNDTRIP("-2.225073858507201e-308");
     TEST_ROUNDTRIP("2.2250738585072014e-308");  /* Min normal positive double */
     TEST_ROUNDTRIP("-2.2250738585072014e-308");
     TEST_ROUNDTRIP("1.7976931348623157e+308");  /* Max double */
     TEST_ROUNDTRIP("-1.7976931348623157e+308");
+
+    /* shortest digits, "%g" layout */
+    TEST_ROUNDTRIP("0.1");
+    TEST_ROUNDTRIP("0.3");
+    TEST_ROUNDTRIP("0.30000000000000004");
+    TEST_ROUNDTRIP("123.456");
+    TEST_ROUNDTRIP("0.0001");
+    TEST_ROUNDTRIP("1e-05");
+    TEST_ROUNDTRIP("9007199254740991");
+    TEST_ROUNDTRIP("9007199254740992");
+    TEST_ROUNDTRIP("12345678901234568");
+    TEST_ROUNDTRIP("1.2345678901234568e+17");
+    TEST_ROUNDTRIP("1e+100");
+    TEST_STRINGIFY_NUMBER("5e-324", 4.9406564584124654e-324);
+    TEST_STRINGIFY_NUMBER("0.1", 0.1);
+
+    /* the 17-digit forms still parse to the same values */
+    TEST_NUMBER( 4.9406564584124654e-324, "4.9406564584124654e-324");
+    TEST_NUMBER(-4.9406564584124654e-324, "-4.9406564584124654e-324");
+    TEST_NUMBER( 2.2250738585072009e-308, "2.2250738585072009e-308");
+    TEST_NUMBER(-2.2250738585072009e-308, "-2.2250738585072009e-308");
+
+    /* Grisu2 alone gives one digit more for these */
+    TEST_STRINGIFY_NUMBER("5.516483066178686e-124", 5.5164830661786856e-124);
+    TEST_STRINGIFY_NUMBER("8005.109645752294", 8005.1096457522945);
+    TEST_STRINGIFY_NUMBER("2.298988869078836e+17", 2.2989888690788358e+17);
 }
 
 static void test_stringify_string() {
@@ -411,6 +1069,7 @@ static void test_stringify_string() {
     TEST_ROUNDTRIP("\"Hello\\nWorld\"");
     TEST_ROUNDTRIP("\"\\\" \\\\ / \\b \\f \\n \\r \\t\"");
     TEST_ROUNDTRIP("\"Hello\\u0000World\"");
+    TEST_ROUNDTRIP("\"0123456789ABCDEF0123456789ABCDEF\\u001F0123456789ABCDEF0123456789ABCDEF\\\"\"");
 }
 
 static void test_stringify_array() {
@@ -423,6 +1082,99 @@ static void test_stringify_object() {
     TEST_ROUNDTRIP("{\"n\":null,\"f\":false,\"t\":true,\"i\":123,\"s\":\"abc\",\"a\":[1,2,3],\"o\":{\"1\":1,\"2\":2,\"3\":3}}");
 }
 
+typedef struct {
+    char out[256];
+    size_t len, flushes, fail_after;
+}test_sink;
+
+static int test_sink_flush(lept_writer* w, size_t need) {
+    test_sink* sink = (test_sink*)w->user;
+    (void)need;
+    if (sink->fail_after && ++sink->flushes > sink->fail_after)
+        return 42;
+    memcpy(sink->out + sink->len, w->buf, w->top);
+    sink->len += w->top;
+    w->top = 0;
+    return 0;
+}
+
+static void test_stringify_writer() {
+    static const char json[] = "{\"n\":null,\"s\":\"Hello\\nWorld \\u0001 0123456789ABCDEF0123456789ABCDEF\",\"a\":[1.5,-2e-100,3]}";
+    lept_value v;
+    lept_writer w;
+    test_sink sink;
+    char buf[7], fbuf[16], read[sizeof(json)];
+    size_t size;
+    FILE* f;
+
+    lept_init(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, json));
+
+    /* a buffer smaller than any token still produces the whole output */
+    for (size = 1; size <= sizeof(buf); size++) {
+        memset(&sink, 0, sizeof(sink));
+        lept_writer_init(&w, buf, size, test_sink_flush, &sink);
+        EXPECT_EQ_INT(0, lept_stringify_to(&v, &w));
+        EXPECT_EQ_STRING(json, sink.out, sink.len);
+    }
+
+    /* a failing flush stops the output and is reported */
+    memset(&sink, 0, sizeof(sink));
+    sink.fail_after = 2;
+    lept_writer_init(&w, buf, sizeof(buf), test_sink_flush, &sink);
+    EXPECT_EQ_INT(42, lept_stringify_to(&v, &w));
+    EXPECT_EQ_SIZE_T(2 * sizeof(buf), sink.len);
+    EXPECT_EQ_SIZE_T(3, sink.flushes);
+
+    lept_writer_init_buffer(&w);
+    EXPECT_EQ_INT(0, lept_stringify_to(&v, &w));
+    EXPECT_EQ_SIZE_T(sizeof(json) - 1, w.top);
+    EXPECT_TRUE(memcmp(json, w.buf, w.top) == 0);
+    free(w.buf);
+
+    if ((f = tmpfile()) != NULL) {
+        lept_writer_init_file(&w, f, fbuf, sizeof(fbuf));
+        EXPECT_EQ_INT(0, lept_stringify_to(&v, &w));
+        rewind(f);
+        EXPECT_EQ_SIZE_T(sizeof(json) - 1, fread(read, 1, sizeof(read), f));
+        EXPECT_TRUE(memcmp(json, read, sizeof(json) - 1) == 0);
+        fclose(f);
+    }
+
+    lept_writer_init_fd(&w, -1, fbuf, sizeof(fbuf));
+    EXPECT_EQ_INT(-1, lept_stringify_to(&v, &w));
+
+    lept_free(&v);
+}
+
+#define TEST_STRINGIFY_SIZE(json)\
+    do {\
+        lept_value v;\
+        char buf[sizeof(json)];\
+        lept_init(&v);\
+        EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, json));\
+        EXPECT_EQ_SIZE_T(sizeof(json) - 1, lept_stringify_size(&v));\
+        buf[sizeof(json) - 1] = '!';\
+        EXPECT_EQ_SIZE_T(sizeof(json) - 1, lept_stringify_into(&v, buf, sizeof(json) - 1));\
+        EXPECT_TRUE(memcmp(json, buf, sizeof(json) - 1) == 0);\
+        EXPECT_TRUE(buf[sizeof(json) - 1] == '!');\
+        EXPECT_EQ_SIZE_T(sizeof(json) - 1, lept_stringify_into(&v, buf, sizeof(json) - 2));\
+        EXPECT_EQ_SIZE_T(sizeof(json) - 1, lept_stringify_into(&v, NULL, 0));\
+        lept_free(&v);\
+    } while(0)
+
+static void test_stringify_size() {
+    TEST_STRINGIFY_SIZE("null");
+    TEST_STRINGIFY_SIZE("false");
+    TEST_STRINGIFY_SIZE("-1.2345678901234567e-100");
+    TEST_STRINGIFY_SIZE("\"\\\" \\\\ / \\b \\f \\n \\r \\t \\u0001 \\u001F\"");
+    TEST_STRINGIFY_SIZE("[]");
+    TEST_STRINGIFY_SIZE("[1]");
+    TEST_STRINGIFY_SIZE("{}");
+    TEST_STRINGIFY_SIZE("{\"a\\n\":1}");
+    TEST_STRINGIFY_SIZE("{\"n\":null,\"f\":false,\"t\":true,\"i\":123,\"s\":\"abc\",\"a\":[1,2,[]],\"o\":{\"1\":1,\"2\":{}}}");
+}
+
 static void test_stringify() {
     TEST_ROUNDTRIP("null");
     TEST_ROUNDTRIP("false");
@@ -431,6 +1183,8 @@ static void test_stringify() {
     test_stringify_string();
     test_stringify_array();
     test_stringify_object();
+    test_stringify_writer();
+    test_stringify_size();
 }
 
 #define TEST_EQUAL(json1, json2, equality) \
@@ -469,16 +1223,225 @@ static void test_equal() {
     TEST_EQUAL("{\"a\":1,\"b\":2}", "{\"a\":1,\"b\":2,\"c\":3}", 0);
     TEST_EQUAL("{\"a\":{\"b\":{\"c\":{}}}}", "{\"a\":{\"b\":{\"c\":{}}}}", 1);
     TEST_EQUAL("{\"a\":{\"b\":{\"c\":{}}}}", "{\"a\":{\"b\":{\"c\":[]}}}", 0);
+    TEST_EQUAL("{\"a\":[{\"x\":1,\"y\":2}],\"b\":2}", "{\"b\":2,\"a\":[{\"y\":2,\"x\":1}]}", 1);
+    TEST_EQUAL("{\"a\":1,\"b\":2}", "{\"b\":1,\"a\":2}", 0);
+    TEST_EQUAL("{\"a\":1,\"b\":2}", "{\"a\":1,\"c\":2}", 0);
+    /* duplicate keys pair up in order of appearance */
+    TEST_EQUAL("{\"a\":1,\"b\":0,\"a\":2}", "{\"b\":0,\"a\":1,\"a\":2}", 1);
+    TEST_EQUAL("{\"a\":1,\"a\":2}", "{\"a\":2,\"a\":1}", 0);
+    TEST_EQUAL("{\"a\":1,\"a\":1}", "{\"a\":1,\"b\":1}", 0);
+    TEST_EQUAL("{\"a\":1,\"b\":1}", "{\"a\":1,\"a\":1}", 0);
+    TEST_EQUAL("{\"a\":0,\"b\":1,\"c\":2,\"d\":3,\"e\":4,\"f\":5,\"g\":6,\"h\":7,\"i\":8,\"j\":9,\"k\":10,\"l\":11,\"m\":12,\"n\":13,\"o\":14,\"p\":15,\"q\":16}",
+               "{\"q\":16,\"p\":15,\"o\":14,\"n\":13,\"m\":12,\"l\":11,\"k\":10,\"j\":9,\"i\":8,\"h\":7,\"g\":6,\"f\":5,\"e\":4,\"d\":3,\"c\":2,\"b\":1,\"a\":0}", 1);
+    TEST_EQUAL("{\"a\":0,\"b\":1,\"c\":2,\"d\":3,\"e\":4,\"f\":5,\"g\":6,\"h\":7,\"i\":8,\"j\":9,\"k\":10,\"l\":11,\"m\":12,\"n\":13,\"o\":14,\"p\":15,\"q\":16}",
+               "{\"q\":16,\"p\":15,\"o\":14,\"n\":13,\"m\":12,\"l\":11,\"k\":10,\"j\":9,\"i\":8,\"h\":7,\"g\":6,\"f\":5,\"e\":4,\"d\":3,\"c\":2,\"b\":1,\"a\":1}", 0);
+}
+
+#define TEST_HASH(json1, json2, equality) \
+    do {\
+        lept_value v1, v2;\
+        lept_init(&v1);\
+        lept_init(&v2);\
+        EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v1, json1));\
+        EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v2, json2));\
+        EXPECT_EQ_INT(equality, lept_hash(&v1) == lept_hash(&v2));\
+        lept_free(&v1);\
+        lept_free(&v2);\
+    } while(0)
+
+static void test_hash() {
+    TEST_HASH("null", "null", 1);
+    TEST_HASH("null", "false", 0);
+    TEST_HASH("0", "-0", 1);
+    TEST_HASH("1.5", "15e-1", 1);
+    TEST_HASH("1", "2", 0);
+    TEST_HASH("\"abc\"", "\"abc\"", 1);
+    TEST_HASH("\"abc\"", "\"abd\"", 0);
+    TEST_HASH("[1,[2,\"3\"]]", "[1,[2,\"3\"]]", 1);
+    TEST_HASH("[1,2]", "[2,1]", 0);
+    TEST_HASH("[[]]", "[{}]", 0);
+    TEST_HASH("{\"a\":[{\"x\":1,\"y\":2}],\"b\":2}", "{\"b\":2,\"a\":[{\"y\":2,\"x\":1}]}", 1);
+    TEST_HASH("{\"a\":1,\"b\":2}", "{\"a\":2,\"b\":1}", 0);
+    TEST_HASH("{\"a\":1,\"b\":2}", "{\"a\":1,\"b\":2,\"c\":3}", 0);
+}
+
+static void test_equal_deep() {
+    lept_value v1, v2, *e;
+    size_t i;
+
+    /* deeper than any call stack would allow for recursion */
+    lept_init(&v1);
+    for (e = &v1, i = 0; i < 200000; i++) {
+        lept_set_array(e, 1);
+        e = lept_pushback_array_element(e);
+    }
+    lept_set_string(e, "x", 1);
+    lept_init(&v2);
+    lept_copy(&v2, &v1);
+    EXPECT_TRUE(lept_is_equal(&v1, &v2));
+    lept_set_string(e, "y", 1);
+    EXPECT_FALSE(lept_is_equal(&v1, &v2));
+    lept_free(&v1);
+    lept_free(&v2);
 }
 
 static void test_copy() {
+    static const char json[] = "{\"t\":true,\"f\":false,\"n\":null,\"d\":1.5,\"s\":\"abc\",\"a\":[1,\"2\",[3,{}],{\"4\":[]}],\"o\":{\"1\":{\"2\":\"3\"}}}";
     lept_value v1, v2;
+    lept_arena arena;
+    char insitu[sizeof(json)], *s;
+    size_t len, i;
+    lept_parse_options options;
+
+    memset(&options, 0, sizeof(options));
     lept_init(&v1);
-    lept_parse(&v1, "{\"t\":true,\"f\":false,\"n\":null,\"d\":1.5,\"a\":[1,2,3]}");
+    lept_parse(&v1, json);
     lept_init(&v2);
     lept_copy(&v2, &v1);
     EXPECT_TRUE(lept_is_equal(&v2, &v1));
     lept_free(&v1);
+    s = lept_stringify(&v2, &len);
+    EXPECT_EQ_STRING(json, s, len);
+    free(s);
+    EXPECT_EQ_SIZE_T(4, lept_get_array_capacity(lept_find_object_value(&v2, "a", 1)));
+
+    /* the copy owns everything even when the source does not */
+    lept_arena_init(&arena);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_arena(&v1, &arena, json));
+    lept_copy(&v2, &v1);
+    lept_arena_destroy(&arena);
+    s = lept_stringify(&v2, &len);
+    EXPECT_EQ_STRING(json, s, len);
+    free(s);
+
+    memcpy(insitu, json, sizeof(json));
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_insitu(&v1, insitu));
+    lept_copy(&v2, &v1);
+    lept_free(&v1);
+    memset(insitu, 0, sizeof(insitu));
+    s = lept_stringify(&v2, &len);
+    EXPECT_EQ_STRING(json, s, len);
+    free(s);
+
+    /* copying a value into its own container */
+    lept_copy(&v2, lept_get_array_element(lept_find_object_value(&v2, "a", 1), 2));
+    s = lept_stringify(&v2, &len);
+    EXPECT_EQ_STRING("[3,{}]", s, len);
+    free(s);
+    lept_free(&v2);
+
+    /* deep nesting */
+    s = (char*)malloc(20000);
+    for (i = 0; i < 10000; i++) {
+        s[i] = '[';
+        s[19999 - i] = ']';
+    }
+    EXPECT_EQ_INT(LEPT_PARSE_NESTING_TOO_DEEP, lept_parse_n(&v1, s, 20000));
+    options.max_depth = 10000;
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_ex(&v1, s, 20000, &options));
+    lept_copy(&v2, &v1);
+    EXPECT_TRUE(lept_is_equal(&v1, &v2));
+    lept_free(&v1);
+    lept_free(&v2);
+    free(s);
+}
+
+static void test_share() {
+    /* strings longer than LEPT_SHORT_STRING_MAX, which are not copied into each value */
+    static const char json[] = "{\"s\":\"abcdefghijklmnopqrstuvwxyz\",\"a\":[1,[2,\"xxxxxxxxxxxxxxxxxxxxxxxx\"],{\"b\":[]}],\"o\":{\"k\":\"v\"}}";
+    lept_value v1, v2, v3, *a;
+    lept_arena arena;
+    char* s;
+    char* buf;
+    size_t len, i;
+
+    lept_init(&v1);
+    lept_init(&v2);
+    lept_init(&v3);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v1, json));
+    lept_share(&v2, &v1);
+    lept_share(&v3, &v1);
+    EXPECT_TRUE(lept_is_equal(&v1, &v2));
+
+    /* modifying one copy copies the path to the change only */
+    a = lept_get_array_element(lept_find_object_value(&v2, "a", 1), 1);
+    lept_set_number(lept_get_array_element(a, 0), 3.0);
+    lept_pushback_array_element(lept_find_object_value(&v3, "a", 1));
+    s = lept_stringify(&v1, &len);
+    EXPECT_EQ_STRING("{\"s\":\"abcdefghijklmnopqrstuvwxyz\",\"a\":[1,[2,\"xxxxxxxxxxxxxxxxxxxxxxxx\"],{\"b\":[]}],\"o\":{\"k\":\"v\"}}", s, len);
+    free(s);
+    s = lept_stringify(&v2, &len);
+    EXPECT_EQ_STRING("{\"s\":\"abcdefghijklmnopqrstuvwxyz\",\"a\":[1,[3,\"xxxxxxxxxxxxxxxxxxxxxxxx\"],{\"b\":[]}],\"o\":{\"k\":\"v\"}}", s, len);
+    free(s);
+    s = lept_stringify(&v3, &len);
+    EXPECT_EQ_STRING("{\"s\":\"abcdefghijklmnopqrstuvwxyz\",\"a\":[1,[2,\"xxxxxxxxxxxxxxxxxxxxxxxx\"],{\"b\":[]},null],\"o\":{\"k\":\"v\"}}", s, len);
+    free(s);
+    EXPECT_TRUE(lept_get_string(lept_find_object_value(&v1, "s", 1)) == lept_get_string(lept_find_object_value(&v2, "s", 1)));
+    EXPECT_TRUE(lept_get_string(lept_get_array_element(a, 1)) == lept_get_string(lept_get_array_element(
+        lept_get_array_element(lept_find_object_value(&v1, "a", 1), 1), 1)));
+
+    /* any copy can go first */
+    lept_free(&v1);
+    lept_set_string(lept_find_object_value(&v3, "s", 1), "def", 3);
+    lept_free(&v2);
+    s = lept_stringify(&v3, &len);
+    EXPECT_EQ_STRING("{\"s\":\"def\",\"a\":[1,[2,\"xxxxxxxxxxxxxxxxxxxxxxxx\"],{\"b\":[]},null],\"o\":{\"k\":\"v\"}}", s, len);
+    free(s);
+
+    /* sharing a part of itself */
+    lept_share(&v3, lept_find_object_value(&v3, "o", 1));
+    s = lept_stringify(&v3, &len);
+    EXPECT_EQ_STRING("{\"k\":\"v\"}", s, len);
+    free(s);
+    lept_free(&v3);
+
+    /* arena storage cannot be shared and is copied */
+    lept_arena_init(&arena);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_arena(&v1, &arena, json));
+    lept_share(&v2, &v1);
+    lept_arena_destroy(&arena);
+    s = lept_stringify(&v2, &len);
+    EXPECT_EQ_STRING(json, s, len);
+    free(s);
+
+    /* nor can arena strings */
+    lept_free(&v2);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_arena(&v1, &arena, "[\"abcdefghijklmnopqrstuvwxyz\"]"));
+    lept_share(&v2, lept_get_array_element(&v1, 0));
+    lept_arena_reset(&arena);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_arena(&v1, &arena, "[\"ABCDEFGHIJKLMNOPQRSTUVWXYZ\"]"));
+    EXPECT_EQ_STRING("abcdefghijklmnopqrstuvwxyz", lept_get_string(&v2), lept_get_string_length(&v2));
+    lept_arena_destroy(&arena);
+
+    /* nor can containers whose strings or keys are in in situ text */
+    lept_free(&v2);
+    buf = (char*)malloc(sizeof(json));
+    memcpy(buf, json, sizeof(json));
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_insitu(&v1, buf));
+    lept_share(&v2, &v1);
+    lept_share(&v3, lept_find_object_value(&v1, "a", 1));
+    lept_free(&v1);
+    free(buf);
+    s = lept_stringify(&v2, &len);
+    EXPECT_EQ_STRING(json, s, len);
+    free(s);
+    s = lept_stringify(&v3, &len);
+    EXPECT_EQ_STRING("[1,[2,\"xxxxxxxxxxxxxxxxxxxxxxxx\"],{\"b\":[]}]", s, len);
+    free(s);
+    lept_free(&v3);
+
+    /* lookups in a shared object do not build an index in the shared storage */
+    lept_free(&v2);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v1, "{\"a\":0,\"b\":1,\"c\":2,\"d\":3,\"e\":4,\"f\":5,\"g\":6,\"h\":7,"
+        "\"i\":8,\"j\":9,\"k\":10,\"l\":11,\"m\":12,\"n\":13,\"o\":14,\"p\":15,\"q\":16,\"r\":17}"));
+    lept_share(&v2, &v1);
+    for (i = 0; i < 18; i++) {
+        char key = (char)('a' + i);
+        EXPECT_EQ_SIZE_T(i, lept_find_object_index(&v1, &key, 1));
+        EXPECT_EQ_DOUBLE((double)i, lept_get_number(lept_find_object_value(&v2, &key, 1)));
+        EXPECT_EQ_SIZE_T(i, lept_find_object_index(&v1, &key, 1));
+    }
+    lept_free(&v1);
     lept_free(&v2);
 }
 
@@ -546,9 +1509,49 @@ static void test_access_string() {
     EXPECT_EQ_STRING("", lept_get_string(&v), lept_get_string_length(&v));
     lept_set_string(&v, "Hello", 5);
     EXPECT_EQ_STRING("Hello", lept_get_string(&v), lept_get_string_length(&v));
+    lept_set_string(&v, NULL, 0);
+    EXPECT_EQ_STRING("", lept_get_string(&v), lept_get_string_length(&v));
     lept_free(&v);
 }
 
+static void test_access_short_string() {
+    static const char text[] = "abcdefghijklmnopqrstuvwxyz0123456789";
+    lept_value v, c, a;
+    size_t len, n;
+    char* json;
+
+    lept_init(&a);
+    lept_set_array(&a, 0);
+    for (n = 0; n <= LEPT_SHORT_STRING_MAX + 2; n++) {
+        lept_init(&v);
+        lept_init(&c);
+        lept_set_string(&v, text, n);
+        EXPECT_EQ_SIZE_T(n, lept_get_string_length(&v));
+        EXPECT_TRUE(memcmp(text, lept_get_string(&v), n) == 0 && lept_get_string(&v)[n] == '\0');
+        /* stored in the value itself up to the limit */
+        EXPECT_EQ_INT(n <= LEPT_SHORT_STRING_MAX, lept_get_string(&v) >= (const char*)&v && lept_get_string(&v) < (const char*)(&v + 1));
+        lept_copy(&c, &v);
+        EXPECT_TRUE(lept_is_equal(&c, &v));
+        EXPECT_EQ_SIZE_T(lept_hash(&v), lept_hash(&c));
+        lept_share(&c, &v);
+        EXPECT_TRUE(lept_is_equal(&c, &v));
+        lept_move(lept_pushback_array_element(&a), &v);
+        lept_free(&c);
+    }
+    /* parsed strings too */
+    json = lept_stringify(&a, &len);
+    lept_free(&a);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_n(&a, json, len));
+    free(json);
+    for (n = 0; n <= LEPT_SHORT_STRING_MAX + 2; n++) {
+        lept_value* e = lept_get_array_element(&a, n);
+        EXPECT_EQ_SIZE_T(n, lept_get_string_length(e));
+        EXPECT_TRUE(memcmp(text, lept_get_string(e), n) == 0 && lept_get_string(e)[n] == '\0');
+        EXPECT_EQ_INT(n <= LEPT_SHORT_STRING_MAX, lept_get_string(e) >= (const char*)e && lept_get_string(e) < (const char*)(e + 1));
+    }
+    lept_free(&a);
+}
+
 static void test_access_array() {
     lept_value a, e;
     size_t i, j;
@@ -591,15 +1594,13 @@ static void test_access_array() {
     for (i = 0; i < 6; i++)
         EXPECT_EQ_DOUBLE((double)i + 2, lept_get_number(lept_get_array_element(&a, i)));
 
-#if 0
     for (i = 0; i < 2; i++) {
         lept_init(&e);
         lept_set_number(&e, i);
         lept_move(lept_insert_array_element(&a, i), &e);
         lept_free(&e);
     }
-#endif
-    
+
     EXPECT_EQ_SIZE_T(8, lept_get_array_size(&a));
     for (i = 0; i < 8; i++)
         EXPECT_EQ_DOUBLE((double)i, lept_get_number(lept_get_array_element(&a, i)));
@@ -625,8 +1626,54 @@ static void test_access_array() {
     lept_free(&a);
 }
 
+static void test_access_array_range() {
+    lept_value a, b, *e;
+    size_t i;
+
+    lept_init(&a);
+    lept_set_array(&a, 0);
+    for (i = 0; i < 4; i++)
+        lept_set_number(lept_pushback_array_element(&a), (double)i);
+
+    /* [0, 1, 2, 3] -> [0, 1, "x", null, "z", 2, 3], with a single growth */
+    e = lept_insert_array_elements(&a, 2, 3);
+    EXPECT_EQ_SIZE_T(7, lept_get_array_size(&a));
+    EXPECT_EQ_SIZE_T(8, lept_get_array_capacity(&a));
+    EXPECT_EQ_INT(LEPT_NULL, lept_get_type(&e[1]));
+    lept_set_string(&e[0], "x", 1);
+    lept_set_string(&e[2], "z", 1);
+    EXPECT_EQ_DOUBLE(1.0, lept_get_number(lept_get_array_element(&a, 1)));
+    EXPECT_EQ_DOUBLE(2.0, lept_get_number(lept_get_array_element(&a, 5)));
+    EXPECT_EQ_DOUBLE(3.0, lept_get_number(lept_get_array_element(&a, 6)));
+
+    /* inserting into a shared array leaves the other copy alone */
+    lept_init(&b);
+    lept_share(&b, &a);
+    lept_insert_array_elements(&b, 7, 2);
+    EXPECT_EQ_SIZE_T(7, lept_get_array_size(&a));
+    EXPECT_EQ_SIZE_T(9, lept_get_array_size(&b));
+    lept_erase_array_element(&b, 0, 5);
+    EXPECT_EQ_SIZE_T(4, lept_get_array_size(&b));
+    EXPECT_EQ_DOUBLE(2.0, lept_get_number(lept_get_array_element(&b, 0)));
+    EXPECT_EQ_STRING("z", lept_get_string(lept_get_array_element(&a, 4)), lept_get_string_length(lept_get_array_element(&a, 4)));
+    lept_clear_array(&b);
+    EXPECT_EQ_SIZE_T(0, lept_get_array_size(&b));
+    EXPECT_TRUE(lept_get_array_capacity(&b) >= 9);
+    EXPECT_EQ_SIZE_T(7, lept_get_array_size(&a));
+    lept_free(&b);
+
+    /* the strings are freed with the erased elements */
+    lept_erase_array_element(&a, 1, 4);
+    EXPECT_EQ_SIZE_T(3, lept_get_array_size(&a));
+    EXPECT_EQ_DOUBLE(0.0, lept_get_number(lept_get_array_element(&a, 0)));
+    EXPECT_EQ_DOUBLE(2.0, lept_get_number(lept_get_array_element(&a, 1)));
+    EXPECT_EQ_DOUBLE(3.0, lept_get_number(lept_get_array_element(&a, 2)));
+    lept_insert_array_elements(&a, 3, 0);
+    EXPECT_EQ_SIZE_T(3, lept_get_array_size(&a));
+    lept_free(&a);
+}
+
 static void test_access_object() {
-#if 0
     lept_value o, v, *pv;
     size_t i, j, index;
 
@@ -695,16 +1742,335 @@ static void test_access_object() {
     EXPECT_EQ_SIZE_T(0, lept_get_object_capacity(&o));
 
     lept_free(&o);
+}
+
+static void test_find_object_index() {
+    lept_arena a;
+    lept_value o;
+    char json[2048], key[8];
+    size_t i, n;
+
+    /* wide enough to be indexed, with a duplicate key */
+    n = 0;
+    json[n++] = '{';
+    for (i = 0; i < 100; i++)
+        n += sprintf(json + n, "\"k%d\":%d,", (int)i, (int)i);
+    n += sprintf(json + n, "\"k7\":-1}");
+
+    lept_init(&o);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&o, json));
+    for (i = 0; i < 100; i++) {
+        sprintf(key, "k%d", (int)i);
+        EXPECT_EQ_SIZE_T(i, lept_find_object_index(&o, key, strlen(key)));
+    }
+    EXPECT_EQ_DOUBLE(7.0, lept_get_number(lept_find_object_value(&o, "k7", 2)));
+    EXPECT_TRUE(lept_find_object_value(&o, "k100", 4) == NULL);
+    EXPECT_TRUE(lept_find_object_value(&o, "k", 1) == NULL);
+    lept_free(&o);
+
+    lept_arena_init(&a);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_arena(&o, &a, json));
+    for (i = 0; i < 100; i++) {
+        sprintf(key, "k%d", (int)i);
+        EXPECT_EQ_SIZE_T(i, lept_find_object_index(&o, key, strlen(key)));
+    }
+    EXPECT_TRUE(lept_find_object_value(&o, "k100", 4) == NULL);
+    lept_arena_destroy(&a);
+}
+
+/* every key k0..k{n-1} not in [gone, gone + 1) maps to its number */
+static void test_object_keys(lept_value* o, size_t n, size_t gone) {
+    char key[8];
+    size_t i;
+    lept_value* pv;
+    EXPECT_EQ_SIZE_T(gone < n ? n - 1 : n, lept_get_object_size(o));
+    for (i = 0; i < n; i++) {
+        sprintf(key, "k%d", (int)i);
+        pv = lept_find_object_value(o, key, strlen(key));
+        if (i == gone)
+            EXPECT_TRUE(pv == NULL);
+        else {
+            EXPECT_TRUE(pv != NULL);
+            if (pv != NULL)
+                EXPECT_EQ_DOUBLE((double)i, lept_get_number(pv));
+        }
+    }
+}
+
+static void test_access_object_ex() {
+    lept_arena a;
+    lept_value o, c;
+    lept_member m[40];
+    char keys[40][8], json[1024];
+    size_t i, n;
+
+    /* bulk insert with one growth, the index is kept up to date */
+    for (i = 0; i < 40; i++) {
+        m[i].klen = sprintf(keys[i], "k%d", (int)i);
+        m[i].k = keys[i];
+        lept_init(&m[i].v);
+        lept_set_number(&m[i].v, (double)i);
+    }
+    lept_init(&o);
+    lept_set_object(&o, 0);
+    lept_set_object_values(&o, m, 40);
+    EXPECT_EQ_SIZE_T(40, lept_get_object_capacity(&o));
+    EXPECT_EQ_INT(LEPT_NULL, lept_get_type(&m[0].v));
+    test_object_keys(&o, 40, 40);
+
+    /* the same keys again replace the values */
+    for (i = 0; i < 40; i++)
+        lept_set_string(&m[i].v, "x", 1);
+    lept_set_object_values(&o, m, 2);
+    EXPECT_EQ_SIZE_T(40, lept_get_object_size(&o));
+    EXPECT_EQ_STRING("x", lept_get_string(lept_find_object_value(&o, "k1", 2)), 1);
+    lept_set_number(lept_find_object_value(&o, "k0", 2), 0.0);
+    lept_set_number(lept_find_object_value(&o, "k1", 2), 1.0);
+    for (i = 0; i < 40; i++)
+        lept_free(&m[i].v);
+
+    /* swap remove moves the last member into the hole */
+    lept_init(&c);
+    lept_share(&c, &o);
+    lept_swap_remove_object_value(&o, lept_find_object_index(&o, "k5", 2));
+    EXPECT_EQ_SIZE_T(5, lept_find_object_index(&o, "k39", 3));
+    test_object_keys(&o, 40, 5);
+    test_object_keys(&c, 40, 40);
+    for (i = 0; i < 39; i++) {
+        if (i == 5)
+            continue;
+        sprintf(json, "k%d", (int)i);
+        lept_swap_remove_object_value(&o, lept_find_object_index(&o, json, strlen(json)));
+        EXPECT_TRUE(lept_find_object_value(&o, json, strlen(json)) == NULL);
+    }
+    EXPECT_EQ_SIZE_T(1, lept_get_object_size(&o));
+    EXPECT_EQ_STRING("k39", lept_get_object_key(&o, 0), lept_get_object_key_length(&o, 0));
+
+    /* ordered remove keeps the order */
+    lept_remove_object_value(&c, lept_find_object_index(&c, "k5", 2));
+    test_object_keys(&c, 40, 5);
+    EXPECT_EQ_STRING("k6", lept_get_object_key(&c, 5), lept_get_object_key_length(&c, 5));
+    EXPECT_EQ_STRING("k39", lept_get_object_key(&c, 38), lept_get_object_key_length(&c, 38));
+    lept_shrink_object(&c);
+    EXPECT_EQ_SIZE_T(39, lept_get_object_capacity(&c));
+    test_object_keys(&c, 40, 5);
+
+    /* clearing a shared object leaves the other copy alone */
+    lept_share(&o, &c);
+    lept_clear_object(&o);
+    EXPECT_EQ_SIZE_T(0, lept_get_object_size(&o));
+    EXPECT_EQ_SIZE_T(39, lept_get_object_capacity(&o));
+    EXPECT_TRUE(lept_find_object_value(&o, "k6", 2) == NULL);
+    lept_set_number(lept_set_object_value(&o, "k6", 2), 6.0);
+    EXPECT_EQ_SIZE_T(1, lept_get_object_size(&o));
+    test_object_keys(&c, 40, 5);
+    lept_free(&o);
+    lept_free(&c);
+
+    /* arena objects move to the heap and take ownership of their keys */
+    n = 0;
+    json[n++] = '{';
+    for (i = 0; i < 20; i++)
+        n += sprintf(json + n, "%s\"k%d\":%d", i ? "," : "", (int)i, (int)i);
+    json[n++] = '}';
+    json[n] = '\0';
+    lept_arena_init(&a);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_arena(&o, &a, json));
+    lept_set_number(lept_set_object_value(&o, "k20", 3), 20.0);
+    test_object_keys(&o, 21, 21);
+    lept_swap_remove_object_value(&o, 3);
+    test_object_keys(&o, 21, 3);
+    lept_arena_destroy(&a);
+    test_object_keys(&o, 21, 3);
+    lept_free(&o);
+
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_insitu(&o, json));
+    lept_remove_object_value(&o, 0);
+    lept_reserve_object(&o, 100);
+    EXPECT_EQ_SIZE_T(100, lept_get_object_capacity(&o));
+    lept_set_number(lept_set_object_value(&o, "k0", 2), 0.0);
+    memset(json, 0, sizeof(json));
+    test_object_keys(&o, 20, 20);
+    lept_free(&o);
+}
+
+static void test_value_size() {
+#ifdef LEPT_COMPACT
+    /* a pointer or a double, the size, the type and the flags */
+    EXPECT_TRUE(sizeof(lept_value) <= sizeof(double) + sizeof(lept_size) + 4);
+    EXPECT_TRUE(sizeof(lept_member) <= sizeof(char*) + sizeof(lept_size) + sizeof(lept_value) + 4);
+#else
+    EXPECT_TRUE(sizeof(lept_value) <= sizeof(lept_member*) + 2 * sizeof(size_t) + sizeof(lept_type) + 4);
 #endif
 }
 
+/* looks ptr up in both parsed forms of json and by extracting it, expecting the same result */
+static void test_pointer_case(const char* json, const char* ptr, int expect) {
+    lept_parse_options options;
+    lept_value v, lazy, out;
+    const lept_value* found;
+    memset(&options, 0, sizeof(options));
+    options.lazy = 1;
+    lept_init(&v);
+    lept_init(&lazy);
+    lept_init(&out);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, json));
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_ex(&lazy, json, strlen(json), &options));
+    EXPECT_EQ_INT(expect, lept_pointer_extract(json, strlen(json), ptr, &out));
+    found = lept_pointer_get(&v, ptr);
+    EXPECT_EQ_INT(expect == LEPT_PARSE_OK, found != NULL);
+    if (found != NULL) {
+        EXPECT_TRUE(lept_is_equal(found, &out));
+        EXPECT_TRUE(lept_is_equal(found, lept_pointer_get(&lazy, ptr)));
+    }
+    else {
+        EXPECT_TRUE(lept_pointer_get(&lazy, ptr) == NULL);
+        EXPECT_EQ_INT(LEPT_NULL, lept_get_type(&out));
+    }
+    lept_free(&v);
+    lept_free(&lazy);
+    lept_free(&out);
+}
+
+static void test_pointer() {
+    /* from RFC 6901 */
+    const char* json = " { \"foo\": [\"bar\", \"baz\"], \"\": 0, \"a/b\": 1, \"c%d\": 2, \"e^f\": 3, \"g|h\": 4,"
+        " \"i\\\\j\": 5, \"k\\\"l\": 6, \" \": 7, \"m~n\": 8, \"o\": {\"p\": [null, {\"q\": [true]}]} } ";
+    lept_value v;
+    char* s;
+
+    test_pointer_case(json, "", LEPT_PARSE_OK);
+    test_pointer_case(json, "/foo", LEPT_PARSE_OK);
+    test_pointer_case(json, "/foo/0", LEPT_PARSE_OK);
+    test_pointer_case(json, "/foo/1", LEPT_PARSE_OK);
+    test_pointer_case(json, "/", LEPT_PARSE_OK);
+    test_pointer_case(json, "/a~1b", LEPT_PARSE_OK);
+    test_pointer_case(json, "/c%d", LEPT_PARSE_OK);
+    test_pointer_case(json, "/e^f", LEPT_PARSE_OK);
+    test_pointer_case(json, "/g|h", LEPT_PARSE_OK);
+    test_pointer_case(json, "/i\\j", LEPT_PARSE_OK);
+    test_pointer_case(json, "/k\"l", LEPT_PARSE_OK);
+    test_pointer_case(json, "/ ", LEPT_PARSE_OK);
+    test_pointer_case(json, "/m~0n", LEPT_PARSE_OK);
+    test_pointer_case(json, "/o/p/1/q/0", LEPT_PARSE_OK);
+    test_pointer_case(json, "/o/p/1", LEPT_PARSE_OK);
+    test_pointer_case(json, "/foo/2", LEPT_PARSE_POINTER_NOT_FOUND);
+    test_pointer_case(json, "/foo/-", LEPT_PARSE_POINTER_NOT_FOUND);
+    test_pointer_case(json, "/foo/01", LEPT_PARSE_POINTER_NOT_FOUND);
+    test_pointer_case(json, "/foo/bar", LEPT_PARSE_POINTER_NOT_FOUND);
+    test_pointer_case(json, "/foo/0/0", LEPT_PARSE_POINTER_NOT_FOUND);
+    test_pointer_case(json, "/m~n", LEPT_PARSE_INVALID_POINTER);
+    test_pointer_case(json, "/x", LEPT_PARSE_POINTER_NOT_FOUND);
+    test_pointer_case(json, "/o/p/2", LEPT_PARSE_POINTER_NOT_FOUND);
+    test_pointer_case("{}", "/a", LEPT_PARSE_POINTER_NOT_FOUND);
+    test_pointer_case("[]", "/0", LEPT_PARSE_POINTER_NOT_FOUND);
+    test_pointer_case("[0]", "/99999999999999999999999", LEPT_PARSE_POINTER_NOT_FOUND);
+    test_pointer_case(json, "foo", LEPT_PARSE_INVALID_POINTER);
+    test_pointer_case(json, "/m~2n", LEPT_PARSE_INVALID_POINTER);
+    test_pointer_case(json, "/m~", LEPT_PARSE_INVALID_POINTER);
+    test_pointer_case("{\"\\u0061\":[1,\"]\\\"[\",{\"a\":\"}\"}],\"\\u0062\":2}", "/b", LEPT_PARSE_OK);
+
+    /* only the way to the target is read */
+    lept_init(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_pointer_extract("{\"a\":[1,{\"b\":[2,3]} x", 21, "/a/1/b", &v));
+    s = lept_stringify(&v, NULL);
+    EXPECT_EQ_STRING("[2,3]", s, strlen(s));
+    free(s);
+    lept_free(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_EXPECT_VALUE, lept_pointer_extract("[1,", 3, "/1", &v));
+    EXPECT_EQ_INT(LEPT_PARSE_EXPECT_VALUE, lept_pointer_extract(" ", 1, "/1", &v));
+    EXPECT_EQ_INT(LEPT_PARSE_INVALID_VALUE, lept_pointer_extract("{\"a\":tru}", 9, "/a", &v));
+    EXPECT_EQ_INT(LEPT_PARSE_MISS_QUOTATION_MARK, lept_pointer_extract("{\"a\":\"x\\\"", 9, "/b", &v));
+    EXPECT_EQ_INT(LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET, lept_pointer_extract("[[1,{]", 6, "/1", &v));
+    EXPECT_EQ_INT(LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET, lept_pointer_extract("{\"a\":1 \"b\":2}", 13, "/b", &v));
+    EXPECT_EQ_INT(LEPT_PARSE_MISS_KEY, lept_pointer_extract("{\"a\":1,b:2}", 11, "/b", &v));
+    EXPECT_EQ_INT(LEPT_PARSE_MISS_COLON, lept_pointer_extract("{\"a\",1}", 7, "/b", &v));
+    EXPECT_EQ_INT(LEPT_PARSE_INVALID_STRING_ESCAPE, lept_pointer_extract("{\"\\x\":1}", 8, "/b", &v));
+    EXPECT_EQ_INT(LEPT_NULL, lept_get_type(&v));
+}
+
+static void test_pointer_set() {
+    static const char* const ptrs[] = {
+        "/foo/1", "/o/p/1/q/0", "/a~1b", "/o", "/x", "/foo/1", "/m~0n", "/o/p/1", "/foo/-", "/o/p/9", "/k\"l", "/ ", ""
+    };
+    static const char* const invalid[] = { "/a", "b" };
+    const char* json = " { \"foo\": [\"bar\", \"baz\"], \"\": 0, \"a/b\": 1, \"k\\\"l\": 6, \" \": 7, \"m~n\": 8,"
+        " \"o\": {\"p\": [null, {\"q\": [true]}]}, \"a/b\": 2 } ";
+    const size_t n = sizeof(ptrs) / sizeof(ptrs[0]);
+    lept_value out[sizeof(ptrs) / sizeof(ptrs[0])], v;
+    int found[sizeof(ptrs) / sizeof(ptrs[0])];
+    lept_pointer_set* set;
+    size_t i;
+
+    EXPECT_TRUE(lept_pointer_set_new(invalid, 2) == NULL);
+    set = lept_pointer_set_new(ptrs, n);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_pointer_set_extract(set, json, strlen(json), out, found));
+    for (i = 0; i < n; i++) {
+        int ret = lept_pointer_extract(json, strlen(json), ptrs[i], &v);
+        EXPECT_EQ_INT(ret == LEPT_PARSE_OK, found[i]);
+        EXPECT_TRUE(lept_is_equal(&v, &out[i]));
+        lept_free(&v);
+        lept_free(&out[i]);
+    }
+    EXPECT_EQ_INT(LEPT_PARSE_MISS_COLON, lept_pointer_set_extract(set, "{\"foo\":[1,2],\"o\" 1}", 19, out, found));
+    for (i = 0; i < n; i++) {
+        EXPECT_EQ_INT(LEPT_NULL, lept_get_type(&out[i]));
+        EXPECT_FALSE(found[i]);
+    }
+    lept_pointer_set_free(set);
+
+    /* the scan stops after the last target */
+    set = lept_pointer_set_new(ptrs, 3);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_pointer_set_extract(set, "{\"a/b\":1,\"o\":{\"p\":[0,{\"q\":[2]}]},\"foo\":[0,3] x", 46, out, NULL));
+    EXPECT_EQ_DOUBLE(3.0, lept_get_number(&out[0]));
+    EXPECT_EQ_DOUBLE(2.0, lept_get_number(&out[1]));
+    EXPECT_EQ_DOUBLE(1.0, lept_get_number(&out[2]));
+    for (i = 0; i < 3; i++)
+        lept_free(&out[i]);
+    lept_pointer_set_free(set);
+
+    set = lept_pointer_set_new(NULL, 0);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_pointer_set_extract(set, "", 0, NULL, NULL));
+    lept_pointer_set_free(set);
+}
+
+/* only the first of duplicate keys is read, as by lept_pointer_get() */
+static void test_pointer_set_duplicate_keys() {
+    static const char* const ptrs[] = { "/a/y", "/a/x", "/a", "/b/0/z" };
+    const char* json = "{\"a\":{\"x\":1},\"b\":[{}],\"a\":{\"y\":2},\"b\":[{\"z\":3}]}";
+    lept_value v, out[4];
+    int found[4];
+    lept_pointer_set* set = lept_pointer_set_new(ptrs, 4);
+    size_t i;
+
+    lept_init(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, json));
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_pointer_set_extract(set, json, strlen(json), out, found));
+    for (i = 0; i < 4; i++) {
+        const lept_value* e = lept_pointer_get(&v, ptrs[i]);
+        EXPECT_EQ_INT(e != NULL, found[i]);
+        if (e != NULL)
+            EXPECT_TRUE(lept_is_equal(e, &out[i]));
+        lept_free(&out[i]);
+    }
+    EXPECT_FALSE(found[0]);
+    EXPECT_FALSE(found[3]);
+    lept_pointer_set_free(set);
+    lept_free(&v);
+}
+
 static void test_access() {
+    test_value_size();
     test_access_null();
     test_access_boolean();
     test_access_number();
     test_access_string();
+    test_access_short_string();
     test_access_array();
+    test_access_array_range();
     test_access_object();
+    test_access_object_ex();
+    test_find_object_index();
 }
 
 int main() {
@@ -714,10 +2080,16 @@ int main() {
     test_parse();
     test_stringify();
     test_equal();
+    test_equal_deep();
+    test_hash();
     test_copy();
+    test_share();
     test_move();
     test_swap();
     test_access();
+    test_pointer();
+    test_pointer_set();
+    test_pointer_set_duplicate_keys();
     printf("%d/%d (%3.2f%%) passed\n", test_pass, test_count, test_pass * 100.0 / test_count);
     return main_ret;
 }